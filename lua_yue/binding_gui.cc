@@ -1059,10 +1059,35 @@ struct Type<nu::Container> {
            RefMethod(state, &AddChildViewAt, RefType::Ref),
            "removechildview",
            RefMethod(state, &nu::Container::RemoveChildView, RefType::Deref),
+           "addchildviews", &AddChildViews,
+           "beginupdate", &nu::Container::BeginUpdate,
+           "endupdate", &nu::Container::EndUpdate,
            "childcount", &nu::Container::ChildCount,
+#if defined(OS_LINUX)
+           "setrastercache", &nu::Container::SetRasterCache,
+           "israstercacheenabled", &nu::Container::IsRasterCacheEnabled,
+#endif
            "childat", &ChildAt);
     RawSetProperty(state, index, "ondraw", &nu::Container::on_draw);
   }
+  static void AddChildViews(CallContext* context,
+                            nu::Container* c,
+                            std::vector<scoped_refptr<nu::View>> views) {
+    State* state = context->state;
+    c->AddChildViews(views);
+    // self.__yuerefs[view] = 1 for every view added, views owned by other
+    // containers are skipped.
+    StackAutoReset reset(state);
+    PushRefsTable(state, "__yuerefs", 1);
+    int refs = AbsIndex(state, -1);
+    for (size_t i = 0; i < views.size(); ++i) {
+      if (views[i]->GetParent() != c)
+        continue;
+      RawGet(state, 2, static_cast<int>(i + 1));
+      RawSet(state, refs, ValueOnStack(state, -1), 1);
+      PopAndIgnore(state, 1);
+    }
+  }
   // Transalte 1-based index to 0-based.
   static inline void AddChildViewAt(nu::Container* c, nu::View* view, int i) {
     c->AddChildViewAt(view, i - 1);
@@ -1531,6 +1556,7 @@ struct Type<nu::Image> {
     RawSet(state, index,
            "createempty", &CreateOnHeap<nu::Image>,
            "createfrompath", &CreateOnHeap<nu::Image, const base::FilePath&>,
+           "createfrompathasync", &nu::Image::CreateFromPathAsync,
            "createfrombuffer", &CreateOnHeap<nu::Image,
                                              const nu::Buffer&,
                                              float>,
@@ -2036,7 +2062,28 @@ struct Type<nu::Painter> {
            "drawcanvas", &nu::Painter::DrawCanvas,
            "drawcanvasfromrect", &nu::Painter::DrawCanvasFromRect,
            "drawattributedtext", &nu::Painter::DrawAttributedText,
-           "drawtext", &nu::Painter::DrawText);
+           "drawtext", &nu::Painter::DrawText,
+           "drawpicture", &nu::Painter::DrawPicture);
+  }
+};
+
+template<>
+struct Type<nu::Picture> {
+  static constexpr const char* name = "Picture";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "getcommandcount", &nu::Picture::GetCommandCount);
+  }
+};
+
+template<>
+struct Type<nu::PictureRecorder> {
+  static constexpr const char* name = "PictureRecorder";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::PictureRecorder>,
+           "getpainter", &nu::PictureRecorder::GetPainter,
+           "finishrecording", &nu::PictureRecorder::FinishRecording);
   }
 };
 
@@ -2285,6 +2332,16 @@ struct Type<nu::Slider> {
   }
 };
 
+template<>
+struct Type<nu::Style> {
+  static constexpr const char* name = "Style";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::Style,
+                                   const std::map<std::string, std::string>&>);
+  }
+};
+
 template<>
 struct Type<nu::Tab> {
   using Base = nu::View;
@@ -2325,7 +2382,11 @@ struct Type<nu::TableModel> {
            "getvalue", &GetValue,
            "notifyrowinsertion", &NotifyRowInsertion,
            "notifyrowdeletion", &NotifyRowDeletion,
-           "notifyvaluechange", &NotifyValueChange);
+           "notifyvaluechange", &NotifyValueChange,
+           "notifyrowsinserted", &NotifyRowsInserted,
+           "notifyrowsdeleted", &NotifyRowsDeleted,
+           "notifyrangechanged", &NotifyRangeChanged,
+           "notifyreset", &nu::TableModel::NotifyReset);
   }
   static void SetValue(nu::TableModel* model,
                        uint32_t column,
@@ -2347,6 +2408,18 @@ struct Type<nu::TableModel> {
                               uint32_t module, uint32_t row) {
     model->NotifyValueChange(module - 1, row - 1);
   }
+  static void NotifyRowsInserted(nu::TableModel* model,
+                                 uint32_t start, uint32_t count) {
+    model->NotifyRowsInserted(start - 1, count);
+  }
+  static void NotifyRowsDeleted(nu::TableModel* model,
+                                uint32_t start, uint32_t count) {
+    model->NotifyRowsDeleted(start - 1, count);
+  }
+  static void NotifyRangeChanged(nu::TableModel* model,
+                                 uint32_t start, uint32_t count) {
+    model->NotifyRangeChanged(start - 1, count);
+  }
 };
 
 template<>
@@ -2358,13 +2431,38 @@ struct Type<nu::AbstractTableModel> {
     RawSetProperty(state, metatable,
                    "getrowcount", &nu::AbstractTableModel::get_row_count,
                    "setvalue", &nu::AbstractTableModel::set_value,
-                   "getvalue", &nu::AbstractTableModel::get_value);
+                   "getvalue", &nu::AbstractTableModel::get_value,
+                   "getrows", &nu::AbstractTableModel::get_rows);
   }
   static nu::AbstractTableModel* Create() {
     return new nu::AbstractTableModel(false /* index_starts_from_0 */);
   }
 };
 
+template<>
+struct Type<nu::AsyncTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "AsyncTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "setrowcount", &nu::AsyncTableModel::SetRowCount,
+           "setplaceholder", &nu::AsyncTableModel::SetPlaceholder,
+           "fulfillrequest", &nu::AsyncTableModel::FulfillRequest,
+           "reload", &nu::AsyncTableModel::Reload,
+           "isrowloaded", &IsRowLoaded);
+    RawSetProperty(state, metatable,
+                   "requestrows", &nu::AsyncTableModel::request_rows,
+                   "cancelrequest", &nu::AsyncTableModel::cancel_request);
+  }
+  static nu::AsyncTableModel* Create() {
+    return new nu::AsyncTableModel(false /* index_starts_from_0 */);
+  }
+  static bool IsRowLoaded(nu::AsyncTableModel* model, uint32_t row) {
+    return model->IsRowLoaded(row - 1);
+  }
+};
+
 template<>
 struct Type<nu::SimpleTableModel> {
   using Base = nu::TableModel;
@@ -2373,11 +2471,290 @@ struct Type<nu::SimpleTableModel> {
     RawSet(state, metatable,
            "create", &CreateOnHeap<nu::SimpleTableModel, uint32_t>,
            "addrow", &nu::SimpleTableModel::AddRow,
-           "removerowat", &RemoveRowAt);
+           "addrows", &nu::SimpleTableModel::AddRows,
+           "insertrows", &InsertRows,
+           "removerowat", &RemoveRowAt,
+           "removerows", &RemoveRows);
+  }
+  static void InsertRows(nu::SimpleTableModel* model, uint32_t at,
+                         std::vector<nu::SimpleTableModel::Row> rows) {
+    model->InsertRows(at - 1, std::move(rows));
   }
   static void RemoveRowAt(nu::SimpleTableModel* model, uint32_t row) {
     model->RemoveRowAt(row - 1);
   }
+  static void RemoveRows(nu::SimpleTableModel* model,
+                         uint32_t start, uint32_t count) {
+    model->RemoveRows(start - 1, count);
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel::ColumnType> {
+  static constexpr const char* name = "ColumnarTableModelColumnType";
+  static inline bool To(State* state, int index,
+                        nu::ColumnarTableModel::ColumnType* out) {
+    std::string type;
+    if (!lua::To(state, index, &type))
+      return false;
+    if (type == "int64") {
+      *out = nu::ColumnarTableModel::ColumnType::Int64;
+      return true;
+    } else if (type == "double") {
+      *out = nu::ColumnarTableModel::ColumnType::Double;
+      return true;
+    } else if (type == "bool") {
+      *out = nu::ColumnarTableModel::ColumnType::Bool;
+      return true;
+    } else if (type == "string") {
+      *out = nu::ColumnarTableModel::ColumnType::String;
+      return true;
+    } else {
+      return false;
+    }
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "ColumnarTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "appendcolumn", &AppendColumn,
+           "clear", &nu::ColumnarTableModel::Clear,
+           "setcolumnformatter", &SetColumnFormatter);
+  }
+  static nu::ColumnarTableModel* Create(
+      std::vector<nu::ColumnarTableModel::ColumnType> types) {
+    return new nu::ColumnarTableModel(std::move(types));
+  }
+  // The data can be a table of values, or for numeric columns a string that
+  // packs the values in native layout (for example with string.pack).
+  static void AppendColumn(CallContext* context,
+                           nu::ColumnarTableModel* model,
+                           uint32_t column) {
+    State* state = context->state;
+    if (column < 1 || column > model->GetColumnCount()) {
+      context->has_error = true;
+      Push(state, "The arg 2 should be a valid column");
+      return;
+    }
+    column -= 1;
+    auto type = model->GetColumnType(column);
+    if (type != nu::ColumnarTableModel::ColumnType::String &&
+        GetType(state, 3) == LuaType::String) {
+      size_t length = 0;
+      const char* data = lua_tolstring(state, 3, &length);
+      switch (type) {
+        case nu::ColumnarTableModel::ColumnType::Int64:
+          model->AppendInt64s(column, reinterpret_cast<const int64_t*>(data),
+                              length / sizeof(int64_t));
+          break;
+        case nu::ColumnarTableModel::ColumnType::Double:
+          model->AppendDoubles(column, reinterpret_cast<const double*>(data),
+                               length / sizeof(double));
+          break;
+        default:
+          model->AppendBools(column, reinterpret_cast<const uint8_t*>(data),
+                             length);
+          break;
+      }
+      return;
+    }
+    bool success = false;
+    switch (type) {
+      case nu::ColumnarTableModel::ColumnType::Int64: {
+        std::vector<lua_Integer> data;
+        success = To(state, 3, &data);
+        if (success) {
+          std::vector<int64_t> ints(data.begin(), data.end());
+          model->AppendInt64s(column, ints.data(), ints.size());
+        }
+        break;
+      }
+      case nu::ColumnarTableModel::ColumnType::Double: {
+        std::vector<double> data;
+        success = To(state, 3, &data);
+        if (success)
+          model->AppendDoubles(column, data.data(), data.size());
+        break;
+      }
+      case nu::ColumnarTableModel::ColumnType::Bool: {
+        std::vector<bool> data;
+        success = To(state, 3, &data);
+        if (success) {
+          std::vector<uint8_t> bools(data.begin(), data.end());
+          model->AppendBools(column, bools.data(), bools.size());
+        }
+        break;
+      }
+      case nu::ColumnarTableModel::ColumnType::String: {
+        std::vector<std::string> data;
+        success = To(state, 3, &data);
+        if (success)
+          model->AppendStrings(column, data);
+        break;
+      }
+    }
+    if (!success) {
+      context->has_error = true;
+      Push(state, "The arg 3 should be table or string");
+    }
+  }
+  static void SetColumnFormatter(CallContext* context,
+                                 nu::ColumnarTableModel* model,
+                                 uint32_t column) {
+    State* state = context->state;
+    if (column < 1 || column > model->GetColumnCount()) {
+      context->has_error = true;
+      Push(state, "The arg 2 should be a valid column");
+      return;
+    }
+    // Must not reference the formatter in C++, otherwise the model would be
+    // kept alive by its own formatter.
+    nu::ColumnarTableModel::Formatter formatter;
+    if (!ToWeakFunction(state, 3, &formatter)) {
+      context->has_error = true;
+      Push(state, "The arg 3 should be function or nil");
+      return;
+    }
+    model->SetColumnFormatter(column - 1, std::move(formatter));
+    // self.__yueformatters[column] = formatter
+    StackAutoReset reset(state);
+    PushRefsTable(state, "__yueformatters", 1);
+    RawSet(state, -1, column, ValueOnStack(state, 3));
+  }
+};
+
+template<>
+struct Type<nu::ProjectedTableModel::SortKey> {
+  static constexpr const char* name = "ProjectedTableModelSortKey";
+  static inline bool To(State* state, int index,
+                        nu::ProjectedTableModel::SortKey* out) {
+    if (GetType(state, index) != LuaType::Table)
+      return false;
+    uint32_t column;
+    if (!RawGetAndPop(state, index, "column", &column) || column < 1)
+      return false;
+    out->column = column - 1;
+    return ReadOptions(state, index, "ascending", &out->ascending);
+  }
+};
+
+template<>
+struct Type<nu::ProjectedTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "ProjectedTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &CreateOnHeap<nu::ProjectedTableModel,
+                                   scoped_refptr<nu::TableModel>>,
+           "setsortkeys", &nu::ProjectedTableModel::SetSortKeys,
+           "setfilter", &SetFilter,
+           "refilter", &nu::ProjectedTableModel::Refilter,
+           "getsource", &nu::ProjectedTableModel::GetSource,
+           "getsourcerow", &GetSourceRow,
+           "getprojectedrow", &GetProjectedRow);
+  }
+  static void SetFilter(CallContext* context,
+                        nu::ProjectedTableModel* model) {
+    State* state = context->state;
+    // Must not reference the filter in C++, otherwise the model would be kept
+    // alive by its own filter.
+    std::function<bool(nu::TableModel*, uint32_t)> filter;
+    if (!ToWeakFunction(state, 2, &filter)) {
+      context->has_error = true;
+      Push(state, "The arg 2 should be function or nil");
+      return;
+    }
+    // self.__yuemembers.filter = filter
+    StackAutoReset reset(state);
+    PushRefsTable(state, "__yuemembers", 1);
+    RawSet(state, -1, "filter", ValueOnStack(state, 2));
+    if (!filter) {
+      model->SetFilter(nullptr);
+      return;
+    }
+    model->SetFilter([filter](nu::TableModel* source, uint32_t row) {
+      return filter(source, row + 1);
+    });
+  }
+  static int GetSourceRow(nu::ProjectedTableModel* model, uint32_t row) {
+    if (row < 1)
+      return -1;
+    int index = model->GetSourceRow(row - 1);
+    return index == -1 ? -1 : index + 1;
+  }
+  static int GetProjectedRow(nu::ProjectedTableModel* model, uint32_t row) {
+    int index = model->GetProjectedRow(row - 1);
+    return index == -1 ? -1 : index + 1;
+  }
+};
+
+template<>
+struct Type<nu::TreeTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "TreeTableModel";
+  static void BuildMetaTable(State* state, int metatable) {
+    RawSet(state, metatable,
+           "create", &Create,
+           "expand", &Expand,
+           "collapse", &Collapse,
+           "toggle", &Toggle,
+           "isexpanded", &IsExpanded,
+           "isexpandable", &IsExpandable,
+           "getdepth", &GetDepth,
+           "getnode", &GetNode,
+           "getrow", &GetRow,
+           "settreecolumn", &SetTreeColumn,
+           "gettreecolumn", &GetTreeColumn,
+           "notifynodechanged", &nu::TreeTableModel::NotifyNodeChanged,
+           "notifychildrenchanged", &nu::TreeTableModel::NotifyChildrenChanged,
+           "reload", &nu::TreeTableModel::Reload);
+    RawSetProperty(state, metatable,
+                   "getchildren", &nu::TreeTableModel::get_children,
+                   "haschildren", &nu::TreeTableModel::has_children,
+                   "getvalue", &nu::TreeTableModel::get_value,
+                   "setvalue", &nu::TreeTableModel::set_value);
+  }
+  static nu::TreeTableModel* Create() {
+    return new nu::TreeTableModel(false /* index_starts_from_0 */);
+  }
+  // Transalte 1-based index to 0-based.
+  static void Expand(nu::TreeTableModel* model, uint32_t row) {
+    model->Expand(row - 1);
+  }
+  static void Collapse(nu::TreeTableModel* model, uint32_t row) {
+    model->Collapse(row - 1);
+  }
+  static void Toggle(nu::TreeTableModel* model, uint32_t row) {
+    model->Toggle(row - 1);
+  }
+  static bool IsExpanded(nu::TreeTableModel* model, uint32_t row) {
+    return model->IsExpanded(row - 1);
+  }
+  static bool IsExpandable(nu::TreeTableModel* model, uint32_t row) {
+    return model->IsExpandable(row - 1);
+  }
+  static uint32_t GetDepth(nu::TreeTableModel* model, uint32_t row) {
+    return model->GetDepth(row - 1);
+  }
+  static uint32_t GetNode(nu::TreeTableModel* model, uint32_t row) {
+    return model->GetNode(row - 1);
+  }
+  static int GetRow(nu::TreeTableModel* model, uint32_t node) {
+    int row = model->GetRow(node);
+    return row == -1 ? -1 : row + 1;
+  }
+  static void SetTreeColumn(nu::TreeTableModel* model, int column) {
+    model->SetTreeColumn(column == -1 ? -1 : column - 1);
+  }
+  static int GetTreeColumn(nu::TreeTableModel* model) {
+    int column = model->GetTreeColumn();
+    return column == -1 ? -1 : column + 1;
+  }
 };
 
 template<>
@@ -2415,7 +2792,8 @@ struct Type<nu::Table::ColumnOptions> {
     return ReadOptions(state, index,
                        "type", &out->type,
                        "ondraw", &out->on_draw,
-                       "width", &out->width);
+                       "width", &out->width,
+                       "rastercachesize", &out->raster_cache_size);
   }
 };
 
@@ -2446,7 +2824,10 @@ struct Type<nu::Table> {
            "selectrow", &SelectRow,
            "getselectedrow", &GetSelectedRow,
            "selectrows", &SelectRows,
-           "getselectedrows", &GetSelectedRows);
+           "getselectedrows", &GetSelectedRows,
+           "setsearchcolumn", &SetSearchColumn,
+           "getsearchcolumn", &GetSearchColumn,
+           "findrows", &FindRows);
     RawSetProperty(state, metatable,
                    "onselectionchange", &nu::Table::on_selection_change,
                    "onrowactivate", &nu::Table::on_row_activate);
@@ -2471,6 +2852,20 @@ struct Type<nu::Table> {
       one_more.insert(row + 1);
     return one_more;
   }
+  static void SetSearchColumn(nu::Table* table, int column) {
+    table->SetSearchColumn(column > 0 ? column - 1 : -1);
+  }
+  static int GetSearchColumn(nu::Table* table) {
+    int column = table->GetSearchColumn();
+    return column == -1 ? -1 : column + 1;
+  }
+  static std::vector<int> FindRows(nu::Table* table,
+                                   const std::string& prefix) {
+    std::vector<int> rows = table->FindRows(prefix);
+    for (int& row : rows)
+      ++row;
+    return rows;
+  }
 };
 
 template<>
@@ -2741,6 +3136,7 @@ struct Type<nu::View> {
            "getbounds", &nu::View::GetBounds,
            "getboundsinscreen", &nu::View::GetBoundsInScreen,
            "layout", &nu::View::Layout,
+           "layoutimmediately", &nu::View::LayoutImmediately,
            "schedulepaint", &nu::View::SchedulePaint,
            "schedulepaintrect", &nu::View::SchedulePaintRect,
            "setvisible", &nu::View::SetVisible,
@@ -2782,8 +3178,19 @@ struct Type<nu::View> {
                    "handledragupdate", &nu::View::handle_drag_update,
                    "handledrop", &nu::View::handle_drop);
   }
-  static void SetStyle(nu::View* view,
-                       const std::map<std::string, std::string>& styles) {
+  static void SetStyle(CallContext* context, nu::View* view) {
+    // A pre-parsed style object.
+    nu::Style* style;
+    if (To(context->state, 2, &style)) {
+      view->SetStyle(style);
+      return;
+    }
+    std::map<std::string, std::string> styles;
+    if (!To(context->state, 2, &styles)) {
+      context->has_error = true;
+      Push(context->state, "The arg 2 should be Style or table");
+      return;
+    }
     for (const auto& it : styles)
       view->SetStyleProperty(it.first, it.second);
     view->Layout();
@@ -2854,6 +3261,8 @@ struct Type<nu::Window> {
            "settitle", &nu::Window::SetTitle,
            "gettitle", &nu::Window::GetTitle,
            "setbackgroundcolor", &nu::Window::SetBackgroundColor,
+           "setlayoutdeferred", &nu::Window::SetLayoutDeferred,
+           "islayoutdeferred", &nu::Window::IsLayoutDeferred,
 #if defined(OS_MAC)
            "settoolbar", &nu::Window::SetToolbar,
            "gettoolbar", &nu::Window::GetToolbar,
@@ -2911,12 +3320,14 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   // Classes.
   BindType<nu::App>(state, "App");
   BindType<nu::Appearance>(state, "Appearance");
+  BindType<nu::AsyncTableModel>(state, "AsyncTableModel");
   BindType<nu::AttributedText>(state, "AttributedText");
   BindType<nu::Browser>(state, "Browser");
   BindType<nu::Button>(state, "Button");
   BindType<nu::Canvas>(state, "Canvas");
   BindType<nu::Clipboard>(state, "Clipboard");
   BindType<nu::Color>(state, "Color");
+  BindType<nu::ColumnarTableModel>(state, "ColumnarTableModel");
   BindType<nu::ComboBox>(state, "ComboBox");
   BindType<nu::Container>(state, "Container");
   BindType<nu::Cursor>(state, "Cursor");
@@ -2942,7 +3353,10 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::NotificationCenter>(state, "NotificationCenter");
   BindType<nu::Painter>(state, "Painter");
   BindType<nu::Picker>(state, "Picker");
+  BindType<nu::Picture>(state, "Picture");
+  BindType<nu::PictureRecorder>(state, "PictureRecorder");
   BindType<nu::ProgressBar>(state, "ProgressBar");
+  BindType<nu::ProjectedTableModel>(state, "ProjectedTableModel");
   BindType<nu::ProtocolAsarJob>(state, "ProtocolAsarJob");
   BindType<nu::ProtocolFileJob>(state, "ProtocolFileJob");
   BindType<nu::ProtocolStringJob>(state, "ProtocolStringJob");
@@ -2951,6 +3365,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Scroll>(state, "Scroll");
   BindType<nu::Separator>(state, "Separator");
   BindType<nu::Slider>(state, "Slider");
+  BindType<nu::Style>(state, "Style");
   BindType<nu::Tab>(state, "Tab");
   BindType<nu::TableModel>(state, "TableModel");
   BindType<nu::AbstractTableModel>(state, "AbstractTableModel");
@@ -2961,6 +3376,7 @@ extern "C" int luaopen_yue_gui(lua::State* state) {
   BindType<nu::Toolbar>(state, "Toolbar");
 #endif
   BindType<nu::Tray>(state, "Tray");
+  BindType<nu::TreeTableModel>(state, "TreeTableModel");
 #if defined(OS_MAC)
   BindType<nu::Vibrant>(state, "Vibrant");
 #endif
@@ -4,15 +4,14 @@
 
 #include "base/environment.h"
 #include "base/notreached.h"
+#include "base/strings/string_number_conversions.h"
 #include "base/time/time.h"
 #include "napi_yue/binding_ptr.h"
 #include "napi_yue/binding_signal.h"
 #include "napi_yue/binding_value.h"
 #include "napi_yue/node_integration.h"
 
-#if defined(OS_LINUX) || defined(OS_MAC)
-#include "base/strings/string_number_conversions.h"
-#elif defined(OS_WIN)
+#if defined(OS_WIN)
 #include "base/strings/string_util_win.h"
 #endif
 
@@ -1207,12 +1206,42 @@ struct Type<nu::Container> {
         WrapMethod(&nu::Container::RemoveChildView, [](Arguments args) {
           AttachedTable(args).Delete(args[0]);
         }),
+        "addChildViews", &AddChildViews,
+        "beginUpdate", &nu::Container::BeginUpdate,
+        "endUpdate", &nu::Container::EndUpdate,
         "childCount", &nu::Container::ChildCount,
+#if defined(OS_LINUX)
+        "setRasterCache", &nu::Container::SetRasterCache,
+        "isRasterCacheEnabled", &nu::Container::IsRasterCacheEnabled,
+#endif
         "childAt", &nu::Container::ChildAt);
     DefineProperties(
         env, prototype,
         Signal("onDraw", &nu::Container::on_draw));
   }
+  static void AddChildViews(Arguments args, std::vector<napi_value> values) {
+    nu::Container* container;
+    if (!args.GetThis(&container))
+      return;
+    std::vector<scoped_refptr<nu::View>> views;
+    views.reserve(values.size());
+    for (napi_value value : values) {
+      nu::View* view;
+      if (!FromNode(args.Env(), value, &view)) {
+        args.ThrowError("Array of View");
+        return;
+      }
+      views.push_back(view);
+    }
+    container->AddChildViews(views);
+    // Only reference the views that end up in the container, views owned by
+    // other containers are skipped.
+    AttachedTable table(args);
+    for (size_t i = 0; i < views.size(); ++i) {
+      if (views[i]->GetParent() == container)
+        table.Set(values[i], true);
+    }
+  }
 };
 
 template<>
@@ -1698,6 +1727,7 @@ struct Type<nu::Image> {
     Set(env, constructor,
         "createEmpty", &CreateOnHeap<nu::Image>,
         "createFromPath", &CreateOnHeap<nu::Image, const base::FilePath&>,
+        "createFromPathAsync", &nu::Image::CreateFromPathAsync,
         "createFromBuffer", &CreateOnHeap<nu::Image, const nu::Buffer&, float>);
     Set(env, prototype,
         "isEmpty", &nu::Image::IsEmpty,
@@ -2261,7 +2291,33 @@ struct Type<nu::Painter> {
         "drawCanvas", &nu::Painter::DrawCanvas,
         "drawCanvasFromRect", &nu::Painter::DrawCanvasFromRect,
         "drawAttributedText", &nu::Painter::DrawAttributedText,
-        "drawText", &nu::Painter::DrawText);
+        "drawText", &nu::Painter::DrawText,
+        "drawPicture", &nu::Painter::DrawPicture);
+  }
+};
+
+template<>
+struct Type<nu::Picture> {
+  static constexpr const char* name = "Picture";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, prototype,
+        "getCommandCount", &nu::Picture::GetCommandCount);
+  }
+};
+
+template<>
+struct Type<nu::PictureRecorder> {
+  static constexpr const char* name = "PictureRecorder";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::PictureRecorder>);
+    Set(env, prototype,
+        "getPainter", &nu::PictureRecorder::GetPainter,
+        "finishRecording", &nu::PictureRecorder::FinishRecording);
   }
 };
 
@@ -2539,6 +2595,28 @@ struct Type<nu::Slider> {
   }
 };
 
+template<>
+struct Type<nu::Style> {
+  static constexpr const char* name = "Style";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor, "create", &Create);
+  }
+  static nu::Style* Create(napi_env env,
+                           const std::map<std::string, napi_value>& styles) {
+    std::map<std::string, std::string> properties;
+    for (const auto& it : styles) {
+      double number;
+      if (FromNode(env, it.second, &number))
+        properties[it.first] = base::NumberToString(number);
+      else
+        properties[it.first] = FromNodeTo<std::string>(env, it.second);
+    }
+    return new nu::Style(properties);
+  }
+};
+
 template<>
 struct Type<nu::Tab> {
   using Base = nu::View;
@@ -2577,7 +2655,11 @@ struct Type<nu::TableModel> {
         "getValue", &nu::TableModel::GetValue,
         "notifyRowInsertion", &nu::TableModel::NotifyRowInsertion,
         "notifyRowDeletion", &nu::TableModel::NotifyRowDeletion,
-        "notifyValueChange", &nu::TableModel::NotifyValueChange);
+        "notifyValueChange", &nu::TableModel::NotifyValueChange,
+        "notifyRowsInserted", &nu::TableModel::NotifyRowsInserted,
+        "notifyRowsDeleted", &nu::TableModel::NotifyRowsDeleted,
+        "notifyRangeChanged", &nu::TableModel::NotifyRangeChanged,
+        "notifyReset", &nu::TableModel::NotifyReset);
   }
 };
 
@@ -2594,7 +2676,30 @@ struct Type<nu::AbstractTableModel> {
         env, prototype,
         Delegate("getRowCount", &nu::AbstractTableModel::get_row_count),
         Delegate("setValue", &nu::AbstractTableModel::set_value),
-        Delegate("getValue", &nu::AbstractTableModel::get_value));
+        Delegate("getValue", &nu::AbstractTableModel::get_value),
+        Delegate("getRows", &nu::AbstractTableModel::get_rows));
+  }
+};
+
+template<>
+struct Type<nu::AsyncTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "AsyncTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::AsyncTableModel>);
+    Set(env, prototype,
+        "setRowCount", &nu::AsyncTableModel::SetRowCount,
+        "setPlaceholder", &nu::AsyncTableModel::SetPlaceholder,
+        "fulfillRequest", &nu::AsyncTableModel::FulfillRequest,
+        "reload", &nu::AsyncTableModel::Reload,
+        "isRowLoaded", &nu::AsyncTableModel::IsRowLoaded);
+    DefineProperties(
+        env, prototype,
+        Delegate("requestRows", &nu::AsyncTableModel::request_rows),
+        Delegate("cancelRequest", &nu::AsyncTableModel::cancel_request));
   }
 };
 
@@ -2609,11 +2714,307 @@ struct Type<nu::SimpleTableModel> {
         "create", &CreateOnHeap<nu::SimpleTableModel, uint32_t>);
     Set(env, prototype,
         "addRow", &nu::SimpleTableModel::AddRow,
+        "addRows", &nu::SimpleTableModel::AddRows,
+        "insertRows", &nu::SimpleTableModel::InsertRows,
         "removeRowAt", &nu::SimpleTableModel::RemoveRowAt,
+        "removeRows", &nu::SimpleTableModel::RemoveRows,
         "setValue", &nu::SimpleTableModel::SetValue);
   }
 };
 
+template<>
+struct Type<nu::ColumnarTableModel::ColumnType> {
+  static constexpr const char* name = "ColumnarTableModelColumnType";
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::ColumnarTableModel::ColumnType* out) {
+    std::string type;
+    napi_status s = ConvertFromNode(env, value, &type);
+    if (s == napi_ok) {
+      if (type == "int64")
+        *out = nu::ColumnarTableModel::ColumnType::Int64;
+      else if (type == "double")
+        *out = nu::ColumnarTableModel::ColumnType::Double;
+      else if (type == "bool")
+        *out = nu::ColumnarTableModel::ColumnType::Bool;
+      else if (type == "string")
+        *out = nu::ColumnarTableModel::ColumnType::String;
+      else
+        return napi_invalid_arg;
+    }
+    return s;
+  }
+};
+
+template<>
+struct Type<nu::ColumnarTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "ColumnarTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &Create);
+    Set(env, prototype,
+        "appendColumn", &AppendColumn,
+        "clear", &nu::ColumnarTableModel::Clear,
+        "setColumnFormatter", &SetColumnFormatter);
+  }
+  static nu::ColumnarTableModel* Create(
+      std::vector<nu::ColumnarTableModel::ColumnType> types) {
+    return new nu::ColumnarTableModel(std::move(types));
+  }
+  static void SetColumnFormatter(Arguments args,
+                                 uint32_t column,
+                                 napi_value value) {
+    nu::ColumnarTableModel* model;
+    if (!args.GetThis(&model))
+      return;
+    napi_valuetype type;
+    if (napi_typeof(args.Env(), value, &type) == napi_ok &&
+        (type == napi_null || type == napi_undefined)) {
+      AttachedTable(args).GetOrCreateMap("formatters").Delete(args[0]);
+      model->SetColumnFormatter(column, nullptr);
+      return;
+    }
+    // The formatter usually captures the model, so it must not be referenced
+    // by C++.
+    nu::ColumnarTableModel::Formatter formatter;
+    if (ConvertWeakFunctionFromNode(args.Env(), value, &formatter) !=
+            napi_ok) {
+      args.ThrowError("Function");
+      return;
+    }
+    AttachedTable(args).GetOrCreateMap("formatters").Set(args[0], value);
+    model->SetColumnFormatter(column, std::move(formatter));
+  }
+  // Copy the elements of a TypedArray of any type into |out|.
+  template<typename T>
+  static bool ReadTypedArray(napi_env env, napi_value value,
+                             std::vector<T>* out) {
+    bool is_typedarray = false;
+    if (napi_is_typedarray(env, value, &is_typedarray) != napi_ok ||
+        !is_typedarray)
+      return false;
+    napi_typedarray_type type;
+    size_t length;
+    void* data;
+    if (napi_get_typedarray_info(env, value, &type, &length, &data,
+                                 nullptr, nullptr) != napi_ok)
+      return false;
+    switch (type) {
+      case napi_int8_array:
+        CopyElements(static_cast<const int8_t*>(data), length, out);
+        return true;
+      case napi_uint8_array:
+      case napi_uint8_clamped_array:
+        CopyElements(static_cast<const uint8_t*>(data), length, out);
+        return true;
+      case napi_int16_array:
+        CopyElements(static_cast<const int16_t*>(data), length, out);
+        return true;
+      case napi_uint16_array:
+        CopyElements(static_cast<const uint16_t*>(data), length, out);
+        return true;
+      case napi_int32_array:
+        CopyElements(static_cast<const int32_t*>(data), length, out);
+        return true;
+      case napi_uint32_array:
+        CopyElements(static_cast<const uint32_t*>(data), length, out);
+        return true;
+      case napi_float32_array:
+        CopyElements(static_cast<const float*>(data), length, out);
+        return true;
+      case napi_float64_array:
+        CopyElements(static_cast<const double*>(data), length, out);
+        return true;
+      case napi_bigint64_array:
+        CopyElements(static_cast<const int64_t*>(data), length, out);
+        return true;
+      case napi_biguint64_array:
+        CopyElements(static_cast<const uint64_t*>(data), length, out);
+        return true;
+      default:
+        return false;
+    }
+  }
+  template<typename S, typename T>
+  static void CopyElements(const S* data, size_t length, std::vector<T>* out) {
+    out->resize(length);
+    for (size_t i = 0; i < length; ++i)
+      (*out)[i] = static_cast<T>(data[i]);
+  }
+  // The data can be a TypedArray for numeric and bool columns, or an Array.
+  static void AppendColumn(Arguments args, uint32_t column, napi_value value) {
+    nu::ColumnarTableModel* model;
+    if (!args.GetThis(&model))
+      return;
+    if (column >= model->GetColumnCount()) {
+      args.ThrowError("Valid column index");
+      return;
+    }
+    napi_env env = args.Env();
+    // Read the buffer directly when its type matches the column.
+    napi_typedarray_type type;
+    size_t length;
+    void* data;
+    bool is_typedarray = false;
+    if (napi_is_typedarray(env, value, &is_typedarray) == napi_ok &&
+        is_typedarray &&
+        napi_get_typedarray_info(env, value, &type, &length, &data,
+                                 nullptr, nullptr) == napi_ok) {
+      auto column_type = model->GetColumnType(column);
+      if (column_type == nu::ColumnarTableModel::ColumnType::Int64 &&
+          type == napi_bigint64_array) {
+        model->AppendInt64s(column, static_cast<const int64_t*>(data), length);
+        return;
+      }
+      if (column_type == nu::ColumnarTableModel::ColumnType::Double &&
+          type == napi_float64_array) {
+        model->AppendDoubles(column, static_cast<const double*>(data), length);
+        return;
+      }
+      if (column_type == nu::ColumnarTableModel::ColumnType::Bool &&
+          type == napi_uint8_array) {
+        model->AppendBools(column, static_cast<const uint8_t*>(data), length);
+        return;
+      }
+    }
+    bool success = false;
+    switch (model->GetColumnType(column)) {
+      case nu::ColumnarTableModel::ColumnType::Int64: {
+        std::vector<int64_t> ints;
+        std::vector<double> numbers;
+        if (ReadTypedArray(env, value, &ints)) {
+          success = true;
+        } else if (FromNode(env, value, &numbers)) {
+          CopyElements(numbers.data(), numbers.size(), &ints);
+          success = true;
+        }
+        if (success)
+          model->AppendInt64s(column, ints.data(), ints.size());
+        break;
+      }
+      case nu::ColumnarTableModel::ColumnType::Double: {
+        std::vector<double> doubles;
+        success = ReadTypedArray(env, value, &doubles) ||
+                  FromNode(env, value, &doubles);
+        if (success)
+          model->AppendDoubles(column, doubles.data(), doubles.size());
+        break;
+      }
+      case nu::ColumnarTableModel::ColumnType::Bool: {
+        std::vector<uint8_t> bools;
+        std::vector<bool> array;
+        if (ReadTypedArray(env, value, &bools)) {
+          success = true;
+        } else if (FromNode(env, value, &array)) {
+          bools.assign(array.begin(), array.end());
+          success = true;
+        }
+        if (success)
+          model->AppendBools(column, bools.data(), bools.size());
+        break;
+      }
+      case nu::ColumnarTableModel::ColumnType::String: {
+        std::vector<std::string> strings;
+        success = FromNode(env, value, &strings);
+        if (success)
+          model->AppendStrings(column, strings);
+        break;
+      }
+    }
+    if (!success)
+      args.ThrowError("TypedArray or Array");
+  }
+};
+
+template<>
+struct Type<nu::ProjectedTableModel::SortKey> {
+  static constexpr const char* name = "ProjectedTableModelSortKey";
+  static napi_status FromNode(napi_env env,
+                              napi_value value,
+                              nu::ProjectedTableModel::SortKey* out) {
+    if (!Get(env, value, "column", &out->column))
+      return napi_invalid_arg;
+    if (!ReadOptions(env, value, "ascending", &out->ascending))
+      return napi_invalid_arg;
+    return napi_ok;
+  }
+};
+
+template<>
+struct Type<nu::ProjectedTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "ProjectedTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::ProjectedTableModel,
+                                scoped_refptr<nu::TableModel>>);
+    Set(env, prototype,
+        "setSortKeys", &nu::ProjectedTableModel::SetSortKeys,
+        "setFilter", &SetFilter,
+        "refilter", &nu::ProjectedTableModel::Refilter,
+        "getSource", &nu::ProjectedTableModel::GetSource,
+        "getSourceRow", &nu::ProjectedTableModel::GetSourceRow,
+        "getProjectedRow", &nu::ProjectedTableModel::GetProjectedRow);
+  }
+  static void SetFilter(Arguments args, napi_value value) {
+    nu::ProjectedTableModel* model;
+    if (!args.GetThis(&model))
+      return;
+    napi_valuetype type;
+    if (napi_typeof(args.Env(), value, &type) == napi_ok &&
+        (type == napi_null || type == napi_undefined)) {
+      AttachedTable(args).Delete("filter");
+      model->SetFilter(nullptr);
+      return;
+    }
+    // The filter must not be referenced by C++.
+    nu::ProjectedTableModel::Filter filter;
+    if (ConvertWeakFunctionFromNode(args.Env(), value, &filter) != napi_ok) {
+      args.ThrowError("Function");
+      return;
+    }
+    AttachedTable(args).Set("filter", value);
+    model->SetFilter(std::move(filter));
+  }
+};
+
+template<>
+struct Type<nu::TreeTableModel> {
+  using Base = nu::TableModel;
+  static constexpr const char* name = "TreeTableModel";
+  static void Define(napi_env env,
+                     napi_value constructor,
+                     napi_value prototype) {
+    Set(env, constructor,
+        "create", &CreateOnHeap<nu::TreeTableModel>);
+    Set(env, prototype,
+        "expand", &nu::TreeTableModel::Expand,
+        "collapse", &nu::TreeTableModel::Collapse,
+        "toggle", &nu::TreeTableModel::Toggle,
+        "isExpanded", &nu::TreeTableModel::IsExpanded,
+        "isExpandable", &nu::TreeTableModel::IsExpandable,
+        "getDepth", &nu::TreeTableModel::GetDepth,
+        "getNode", &nu::TreeTableModel::GetNode,
+        "getRow", &nu::TreeTableModel::GetRow,
+        "setTreeColumn", &nu::TreeTableModel::SetTreeColumn,
+        "getTreeColumn", &nu::TreeTableModel::GetTreeColumn,
+        "notifyNodeChanged", &nu::TreeTableModel::NotifyNodeChanged,
+        "notifyChildrenChanged", &nu::TreeTableModel::NotifyChildrenChanged,
+        "reload", &nu::TreeTableModel::Reload);
+    DefineProperties(
+        env, prototype,
+        Delegate("getChildren", &nu::TreeTableModel::get_children),
+        Delegate("hasChildren", &nu::TreeTableModel::has_children),
+        Delegate("getValue", &nu::TreeTableModel::get_value),
+        Delegate("setValue", &nu::TreeTableModel::set_value));
+  }
+};
+
 template<>
 struct Type<nu::Table::ColumnType> {
   static constexpr const char* name = "TableColumnType";
@@ -2647,7 +3048,8 @@ struct Type<nu::Table::ColumnOptions> {
                      "onDraw", &on_draw_val,
                      "type", &out->type,
                      "column", &out->column,
-                     "width", &out->width))
+                     "width", &out->width,
+                     "rasterCacheSize", &out->raster_cache_size))
       return napi_invalid_arg;
     if (on_draw_val)
       ConvertWeakFunctionFromNode(env, on_draw_val, &out->on_draw);
@@ -2687,7 +3089,10 @@ struct Type<nu::Table> {
         "selectRow", &nu::Table::SelectRow,
         "getSelectedRow", &nu::Table::GetSelectedRow,
         "selectRows", &nu::Table::SelectRows,
-        "getSelectedRows", &nu::Table::GetSelectedRows);
+        "getSelectedRows", &nu::Table::GetSelectedRows,
+        "setSearchColumn", &nu::Table::SetSearchColumn,
+        "getSearchColumn", &nu::Table::GetSearchColumn,
+        "findRows", &nu::Table::FindRows);
     DefineProperties(
         env, prototype,
         Signal("onSelectionChange", &nu::Table::on_selection_change),
@@ -3006,6 +3411,7 @@ struct Type<nu::View> {
         "getBounds", &nu::View::GetBounds,
         "getBoundsInScreen", &nu::View::GetBoundsInScreen,
         "layout", &nu::View::Layout,
+        "layoutImmediately", &nu::View::LayoutImmediately,
         "schedulePaint", &nu::View::SchedulePaint,
         "schedulePaintRect", &nu::View::SchedulePaintRect,
         "setVisible", &nu::View::SetVisible,
@@ -3048,11 +3454,21 @@ struct Type<nu::View> {
         Delegate("handleDragUpdate", &nu::View::handle_drag_update),
         Delegate("handleDrop", &nu::View::handle_drop));
   }
-  static void SetStyle(Arguments args,
-                       const std::map<std::string, napi_value>& styles) {
+  static void SetStyle(Arguments args, napi_value value) {
     nu::View* view;
     if (!args.GetThis(&view))
       return;
+    // A pre-parsed style object.
+    nu::Style* style;
+    if (FromNode(args.Env(), value, &style)) {
+      view->SetStyle(style);
+      return;
+    }
+    std::map<std::string, napi_value> styles;
+    if (!FromNode(args.Env(), value, &styles)) {
+      args.ThrowError("Style or Object");
+      return;
+    }
     for (const auto& it : styles) {
       float number;
       if (FromNode(args.Env(), it.second, &number))
@@ -3135,6 +3551,8 @@ struct Type<nu::Window> {
         "setTitle", &nu::Window::SetTitle,
         "getTitle", &nu::Window::GetTitle,
         "setBackgroundColor", &nu::Window::SetBackgroundColor,
+        "setLayoutDeferred", &nu::Window::SetLayoutDeferred,
+        "isLayoutDeferred", &nu::Window::IsLayoutDeferred,
 #if defined(OS_MAC)
         "setToolbar",
         WrapMethod(&nu::Window::SetToolbar, [](Arguments args) {
@@ -3247,12 +3665,14 @@ napi_value Initialize(napi_env env, napi_value exports) {
           // Classes.
           "App",                ki::Class<nu::App>(),
           "Appearance",         ki::Class<nu::Appearance>(),
+          "AsyncTableModel",    ki::Class<nu::AsyncTableModel>(),
           "AttributedText",     ki::Class<nu::AttributedText>(),
           "Browser",            ki::Class<nu::Browser>(),
           "Button",             ki::Class<nu::Button>(),
           "Canvas",             ki::Class<nu::Canvas>(),
           "Clipboard",          ki::Class<nu::Clipboard>(),
           "Color",              ki::Class<nu::Color>(),
+          "ColumnarTableModel", ki::Class<nu::ColumnarTableModel>(),
           "ComboBox",           ki::Class<nu::ComboBox>(),
           "Container",          ki::Class<nu::Container>(),
           "Cursor",             ki::Class<nu::Cursor>(),
@@ -3276,7 +3696,10 @@ napi_value Initialize(napi_env env, napi_value exports) {
           "NotificationCenter", ki::Class<nu::NotificationCenter>(),
           "Painter",            ki::Class<nu::Painter>(),
           "Picker",             ki::Class<nu::Picker>(),
+          "Picture",            ki::Class<nu::Picture>(),
+          "PictureRecorder",    ki::Class<nu::PictureRecorder>(),
           "ProgressBar",        ki::Class<nu::ProgressBar>(),
+          "ProjectedTableModel", ki::Class<nu::ProjectedTableModel>(),
           "ProtocolAsarJob",    ki::Class<nu::ProtocolAsarJob>(),
           "ProtocolFileJob",    ki::Class<nu::ProtocolFileJob>(),
           "ProtocolStringJob",  ki::Class<nu::ProtocolStringJob>(),
@@ -3285,6 +3708,7 @@ napi_value Initialize(napi_env env, napi_value exports) {
           "Scroll",             ki::Class<nu::Scroll>(),
           "Separator",          ki::Class<nu::Separator>(),
           "Slider",             ki::Class<nu::Slider>(),
+          "Style",              ki::Class<nu::Style>(),
           "Tab",                ki::Class<nu::Tab>(),
           "TableModel",         ki::Class<nu::TableModel>(),
           "AbstractTableModel", ki::Class<nu::AbstractTableModel>(),
@@ -3295,6 +3719,7 @@ napi_value Initialize(napi_env env, napi_value exports) {
           "Toolbar",            ki::Class<nu::Toolbar>(),
 #endif
           "Tray",               ki::Class<nu::Tray>(),
+          "TreeTableModel",     ki::Class<nu::TreeTableModel>(),
 #if defined(OS_MAC)
           "Vibrant",            ki::Class<nu::Vibrant>(),
 #endif
@@ -17,10 +17,14 @@ namespace napi_yue {
 NodeIntegration::NodeIntegration()
     : uv_loop_(uv_default_loop()),
       embed_closed_(false),
+      embed_thread_started_(false),
       weak_factory_(this) {
 }
 
 NodeIntegration::~NodeIntegration() {
+  if (!embed_thread_started_)
+    return;
+
   // Quit the embed thread.
   embed_closed_ = true;
   uv_sem_post(&embed_sem_);
@@ -42,6 +46,7 @@ void NodeIntegration::PrepareMessageLoop() {
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
   uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  embed_thread_started_ = true;
 }
 
 void NodeIntegration::RunMessageLoop() {
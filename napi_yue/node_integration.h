@@ -22,7 +22,7 @@ class NodeIntegration {
   virtual ~NodeIntegration();
 
   // Prepare for message loop integration.
-  void PrepareMessageLoop();
+  virtual void PrepareMessageLoop();
 
   // Do message loop integration.
   virtual void RunMessageLoop();
@@ -52,6 +52,10 @@ class NodeIntegration {
   // Whether the libuv loop has ended.
   bool embed_closed_;
 
+  // Whether the embed thread has been started, platforms that integrate
+  // libuv into the GUI message loop directly do not use it.
+  bool embed_thread_started_;
+
   // Async handle used for awaking the message loop.
   uv_async_t awake_handle_;
 
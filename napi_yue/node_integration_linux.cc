@@ -5,30 +5,74 @@
 
 #include "napi_yue/node_integration_linux.h"
 
-#include <sys/epoll.h>
+#include "base/notreached.h"
 
 namespace napi_yue {
 
-NodeIntegrationLinux::NodeIntegrationLinux() : epoll_(epoll_create(1)) {
-  int backend_fd = uv_backend_fd(uv_loop_);
-  struct epoll_event ev = { 0 };
-  ev.events = EPOLLIN;
-  ev.data.fd = backend_fd;
-  epoll_ctl(epoll_, EPOLL_CTL_ADD, backend_fd, &ev);
+NodeIntegrationLinux::NodeIntegrationLinux() {
 }
 
 NodeIntegrationLinux::~NodeIntegrationLinux() {
+  if (source_) {
+    g_source_destroy(source_);
+    g_source_unref(source_);
+  }
+}
+
+void NodeIntegrationLinux::PrepareMessageLoop() {
+  static GSourceFuncs funcs = {&NodeIntegrationLinux::OnPrepare,
+                               &NodeIntegrationLinux::OnCheck,
+                               &NodeIntegrationLinux::OnDispatch,
+                               nullptr};
+  source_ = static_cast<UvSource*>(g_source_new(&funcs, sizeof(UvSource)));
+  source_->self = this;
+  source_->fd_tag = g_source_add_unix_fd(source_, uv_backend_fd(uv_loop_),
+                                         G_IO_IN);
+  // JavaScript callbacks may run nested message loops, like showing a modal
+  // dialog, which should still handle libuv events.
+  g_source_set_can_recurse(source_, true);
+  g_source_attach(source_, nullptr);
+}
+
+void NodeIntegrationLinux::RunMessageLoop() {
+  // Run uv loop for once to give the uv__io_poll a chance to add all events.
+  uv_run(uv_loop_, UV_RUN_NOWAIT);
+}
+
+// static
+gboolean NodeIntegrationLinux::OnPrepare(GSource* source, gint* timeout) {
+  *timeout = static_cast<UvSource*>(source)->self->GetUvTimeout();
+  return *timeout == 0;
+}
+
+// static
+gboolean NodeIntegrationLinux::OnCheck(GSource* source) {
+  auto* uv_source = static_cast<UvSource*>(source);
+  if (g_source_query_unix_fd(source, uv_source->fd_tag) & G_IO_IN)
+    return true;
+  // Dispatch when a timer has expired.
+  uv_update_time(uv_source->self->uv_loop_);
+  return uv_source->self->GetUvTimeout() == 0;
+}
+
+// static
+gboolean NodeIntegrationLinux::OnDispatch(GSource* source,
+                                          GSourceFunc,
+                                          gpointer) {
+  uv_run(static_cast<UvSource*>(source)->self->uv_loop_, UV_RUN_NOWAIT);
+  return G_SOURCE_CONTINUE;
 }
 
 void NodeIntegrationLinux::PollEvents() {
-  int timeout = uv_backend_timeout(uv_loop_);
-
-  // Wait for new libuv events.
-  int r;
-  do {
-    struct epoll_event ev;
-    r = epoll_wait(epoll_, &ev, 1, timeout);
-  } while (r == -1 && errno == EINTR);
+  NOTREACHED() << "libuv is polled by the GLib main loop on Linux";
+}
+
+int NodeIntegrationLinux::GetUvTimeout() {
+  // The uv_backend_timeout returns 0 when the loop is not alive, which would
+  // make the GLib loop spin, so only wait for the backend fd in that case.
+  if (!uv_loop_alive(uv_loop_))
+    return -1;
+  return uv_backend_timeout(uv_loop_);
 }
 
 // static
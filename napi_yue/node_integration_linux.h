@@ -6,20 +6,39 @@
 #ifndef NAPI_YUE_NODE_INTEGRATION_LINUX_H_
 #define NAPI_YUE_NODE_INTEGRATION_LINUX_H_
 
+#include <glib.h>
+
 #include "napi_yue/node_integration.h"
 
 namespace napi_yue {
 
+// On Linux the backend fd of libuv is polled by the GLib main loop directly,
+// so there is no need for the embed thread.
 class NodeIntegrationLinux : public NodeIntegration {
  public:
   NodeIntegrationLinux();
   ~NodeIntegrationLinux() override;
 
+  void PrepareMessageLoop() override;
+  void RunMessageLoop() override;
+
  private:
+  struct UvSource : GSource {
+    NodeIntegrationLinux* self;
+    gpointer fd_tag;
+  };
+
+  // GSourceFuncs.
+  static gboolean OnPrepare(GSource* source, gint* timeout);
+  static gboolean OnCheck(GSource* source);
+  static gboolean OnDispatch(GSource* source, GSourceFunc, gpointer);
+
   void PollEvents() override;
 
-  // Epoll to poll for uv's backend fd.
-  int epoll_;
+  // Return the timeout of next libuv timer in milliseconds, -1 for none.
+  int GetUvTimeout();
+
+  UvSource* source_ = nullptr;
 };
 
 }  // namespace napi_yue
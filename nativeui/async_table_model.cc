@@ -0,0 +1,204 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/async_table_model.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+namespace {
+
+// Rows are loaded by blocks of this size.
+constexpr uint32_t kRowsPerBlock = 64;
+
+// How many loaded blocks are kept.
+constexpr size_t kMaxLoadedBlocks = 256;
+
+// Requests of blocks that have not been shown recently are cancelled when
+// there are more requests than this.
+constexpr size_t kMaxPendingRequests = 8;
+
+}  // namespace
+
+AsyncTableModel::AsyncTableModel(bool index_starts_from_0)
+    : index_starts_from_0_(index_starts_from_0) {}
+
+AsyncTableModel::~AsyncTableModel() {}
+
+void AsyncTableModel::SetRowCount(uint32_t count) {
+  if (count == row_count_)
+    return;
+  uint32_t old_count = row_count_;
+  row_count_ = count;
+  if (count > old_count) {
+    // The last block may have been partially loaded.
+    DropRowsAfter(old_count / kRowsPerBlock * kRowsPerBlock);
+    NotifyRowsInserted(old_count, count - old_count);
+  } else {
+    DropRowsAfter(count);
+    NotifyRowsDeleted(count, old_count - count);
+  }
+}
+
+void AsyncTableModel::SetPlaceholder(base::Value value) {
+  placeholder_ = std::move(value);
+}
+
+void AsyncTableModel::FulfillRequest(uint32_t id, base::Value rows) {
+  if (id == 0)
+    return;
+  auto it = std::find_if(requests_.begin(), requests_.end(),
+                         [id](const Request& request) {
+                           return request.id == id;
+                         });
+  if (it == requests_.end())
+    return;
+  uint32_t index = it->block;
+  requests_.erase(it);
+  if (!rows.is_list())
+    return;
+  uint32_t start = index * kRowsPerBlock;
+  uint32_t count = std::min(static_cast<uint32_t>(rows.GetList().size()),
+                            row_count_ - start);
+  // Replace the block if it is already loaded, so the cache never keeps
+  // duplicates.
+  blocks_.remove_if([index](const Block& block) {
+    return block.index == index;
+  });
+  blocks_.push_front({index, std::move(rows)});
+  if (blocks_.size() > kMaxLoadedBlocks)
+    blocks_.pop_back();
+  NotifyRangeChanged(start, count);
+}
+
+void AsyncTableModel::Reload() {
+  DropRowsAfter(0);
+  NotifyRangeChanged(0, row_count_);
+}
+
+bool AsyncTableModel::IsRowLoaded(uint32_t row) const {
+  return FindBlock(row) != nullptr;
+}
+
+uint32_t AsyncTableModel::GetRowCount() const {
+  return row_count_;
+}
+
+base::Value AsyncTableModel::GetValue(uint32_t column, uint32_t row) const {
+  if (row >= row_count_)
+    return base::Value();
+  Block* block = FindBlock(row);
+  if (!block) {
+    RequestBlock(row / kRowsPerBlock);
+    return placeholder_.Clone();
+  }
+  // The delegate may provide fewer rows than requested, the missing rows are
+  // treated as loaded and not requested again.
+  auto& rows = block->rows.GetList();
+  uint32_t offset = row % kRowsPerBlock;
+  if (offset >= rows.size())
+    return placeholder_.Clone();
+  const base::Value& data = rows[offset];
+  if (data.is_list() && column < data.GetList().size())
+    return data.GetList()[column].Clone();
+  return base::Value();
+}
+
+void AsyncTableModel::SetValue(uint32_t column, uint32_t row,
+                               base::Value value) {
+  Block* block = FindBlock(row);
+  if (!block)
+    return;
+  auto& rows = block->rows.GetList();
+  uint32_t offset = row % kRowsPerBlock;
+  if (offset >= rows.size())
+    return;
+  base::Value& data = rows[offset];
+  if (!data.is_list() || column >= data.GetList().size())
+    return;
+  data.GetList()[column] = std::move(value);
+  NotifyValueChange(column, row);
+}
+
+AsyncTableModel::Block* AsyncTableModel::FindBlock(uint32_t row) const {
+  uint32_t index = row / kRowsPerBlock;
+  auto it = std::find_if(blocks_.begin(), blocks_.end(),
+                         [index](const Block& block) {
+                           return block.index == index;
+                         });
+  if (it == blocks_.end())
+    return nullptr;
+  if (it != blocks_.begin())
+    blocks_.splice(blocks_.begin(), blocks_, it);
+  return &blocks_.front();
+}
+
+void AsyncTableModel::RequestBlock(uint32_t index) const {
+  auto it = std::find_if(requests_.begin(), requests_.end(),
+                         [index](const Request& request) {
+                           return request.block == index;
+                         });
+  if (it == requests_.end())
+    requests_.push_front({index, 0});
+  else if (it != requests_.begin())
+    requests_.splice(requests_.begin(), requests_, it);
+  // Requests are sent after painting, which also avoids changing the model
+  // while table is reading it.
+  if (dispatch_scheduled_)
+    return;
+  dispatch_scheduled_ = true;
+  scoped_refptr<AsyncTableModel> self(const_cast<AsyncTableModel*>(this));
+  MessageLoop::PostTask([self]() { self->DispatchRequests(); });
+}
+
+void AsyncTableModel::DispatchRequests() {
+  dispatch_scheduled_ = false;
+  // The least recently shown blocks are likely out of view.
+  while (requests_.size() > kMaxPendingRequests) {
+    uint32_t id = requests_.back().id;
+    requests_.pop_back();
+    if (id != 0 && cancel_request)
+      cancel_request(this, id);
+  }
+  if (!request_rows)
+    return;
+  // Collect the requests first, since delegate may fulfill them immediately.
+  std::vector<Request> pending;
+  for (Request& request : requests_) {
+    if (request.id == 0) {
+      request.id = next_request_id_++;
+      pending.push_back(request);
+    }
+  }
+  for (const Request& request : pending) {
+    uint32_t start = request.block * kRowsPerBlock;
+    uint32_t count = std::min(kRowsPerBlock, row_count_ - start);
+    request_rows(this, request.id,
+                 index_starts_from_0_ ? start : start + 1, count);
+  }
+}
+
+void AsyncTableModel::DropRowsAfter(uint32_t row) {
+  uint32_t index = row / kRowsPerBlock;
+  blocks_.remove_if([index](const Block& block) {
+    return block.index >= index;
+  });
+  for (auto it = requests_.begin(); it != requests_.end();) {
+    if (it->block < index) {
+      ++it;
+      continue;
+    }
+    uint32_t id = it->id;
+    it = requests_.erase(it);
+    if (id != 0 && cancel_request)
+      cancel_request(this, id);
+  }
+}
+
+}  // namespace nu
@@ -0,0 +1,88 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_ASYNC_TABLE_MODEL_H_
+#define NATIVEUI_ASYNC_TABLE_MODEL_H_
+
+#include <functional>
+#include <list>
+
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+// A TableModel that loads rows asynchronously, placeholders are shown for
+// rows that have not been loaded.
+class NATIVEUI_EXPORT AsyncTableModel : public TableModel {
+ public:
+  explicit AsyncTableModel(bool index_starts_from_0 = true);
+
+  // Change the number of rows.
+  void SetRowCount(uint32_t count);
+
+  // The value shown for cells that are being loaded.
+  void SetPlaceholder(base::Value value);
+  const base::Value& GetPlaceholder() const { return placeholder_; }
+
+  // Provide the |rows| for request |id|, which should be a list of rows.
+  // Requests that have been cancelled are ignored. Must be called on the main
+  // thread.
+  void FulfillRequest(uint32_t id, base::Value rows);
+
+  // Drop loaded rows and load them again when they are shown.
+  void Reload();
+
+  bool IsRowLoaded(uint32_t row) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+  // Delegate methods.
+  std::function<void(AsyncTableModel*,
+                     uint32_t id, uint32_t start, uint32_t count)> request_rows;
+  std::function<void(AsyncTableModel*, uint32_t id)> cancel_request;
+
+ protected:
+  ~AsyncTableModel() override;
+
+ private:
+  struct Block {
+    uint32_t index;
+    base::Value rows;
+  };
+
+  struct Request {
+    uint32_t block;
+    // 0 means the request has not been sent.
+    uint32_t id;
+  };
+
+  // Return the loaded block containing |row|, nullptr if it is not loaded.
+  Block* FindBlock(uint32_t row) const;
+
+  // Queue a request for the block.
+  void RequestBlock(uint32_t index) const;
+
+  // Send queued requests and cancel the outdated ones.
+  void DispatchRequests();
+
+  // Cancel all requests and drop blocks after |row|.
+  void DropRowsAfter(uint32_t row);
+
+  bool index_starts_from_0_;
+  uint32_t row_count_ = 0;
+  base::Value placeholder_;
+
+  // Loaded blocks and requests, most recently shown first.
+  mutable std::list<Block> blocks_;
+  mutable std::list<Request> requests_;
+  mutable bool dispatch_scheduled_ = false;
+  uint32_t next_request_id_ = 1;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_ASYNC_TABLE_MODEL_H_
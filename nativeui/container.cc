@@ -9,6 +9,8 @@
 #include <utility>
 
 #include "base/logging.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/window.h"
 #include "third_party/yoga/Yoga.h"
 
 namespace nu {
@@ -47,6 +49,12 @@ const char* Container::GetClassName() const {
 }
 
 void Container::Layout() {
+  // Defer the layout until EndUpdate.
+  if (update_depth_ > 0) {
+    needs_layout_ = true;
+    return;
+  }
+
   // For child CSS node, tell parent to do the layout.
   if (!IsRootYGNode(this)) {
     dirty_ = true;
@@ -55,15 +63,37 @@ void Container::Layout() {
     // changed, in that case we need to force updating here.
     // This usually happens after adding a child view, since the container does
     // not change its size.
+    // When an ancestor is batching updates, the dirty container is updated
+    // when the batch ends.
     // TODO(zcbenz): Revisit the logic here, should have a cleaner way.
-    if (dirty_)
+    if (dirty_ && !IsLayoutDeferred() && !IsInBatchUpdate())
       UpdateChildBounds();
     return;
   }
 
+  // Let the window do the layout before next paint.
+  if (IsLayoutDeferred()) {
+    GetWindow()->ScheduleLayout(this);
+    return;
+  }
+
   UpdateChildBounds();
 }
 
+bool Container::IsLayoutDeferred() const {
+  Window* window = GetWindow();
+  return window && window->IsLayoutDeferred();
+}
+
+bool Container::IsInBatchUpdate() const {
+  for (const View* view = this; view; view = view->GetParent()) {
+    if (view->IsContainer() &&
+        static_cast<const Container*>(view)->update_depth_ > 0)
+      return true;
+  }
+  return false;
+}
+
 bool Container::IsContainer() const {
   return true;
 }
@@ -140,6 +170,33 @@ void Container::RemoveChildView(View* view) {
   Layout();
 }
 
+void Container::AddChildViews(std::vector<scoped_refptr<View>> views) {
+  BeginUpdate();
+  children_.reserve(children_.size() + views.size());
+  for (auto& view : views) {
+    DCHECK(view);
+    // Skip views that are already in this or other containers.
+    if (view->GetParent())
+      continue;
+    AddChildViewAt(std::move(view), ChildCount());
+  }
+  EndUpdate();
+}
+
+void Container::BeginUpdate() {
+  ++update_depth_;
+}
+
+void Container::EndUpdate() {
+  DCHECK_GT(update_depth_, 0) << "EndUpdate called without BeginUpdate";
+  if (update_depth_ == 0 || --update_depth_ > 0)
+    return;
+  if (needs_layout_) {
+    needs_layout_ = false;
+    Layout();
+  }
+}
+
 void Container::UpdateChildBounds() {
   dirty_ = false;
   if (!IsVisibleInHierarchy())
@@ -151,8 +208,24 @@ void Container::UpdateChildBounds() {
   }
   for (int i = 0; i < ChildCount(); ++i) {
     View* child = ChildAt(i);
-    if (child->IsVisibleInHierarchy())
-      child->SetBounds(GetYGNodeBounds(child->node()));
+    if (!child->IsVisibleInHierarchy())
+      continue;
+    // Yoga only sets the flag when the node's layout has been recalculated,
+    // which also means its subtree does not need to be visited otherwise.
+    // Its position may still change because of siblings or parent moving,
+    // so the native bounds are compared too.
+    YGNodeRef node = child->node();
+    RectF bounds = GetYGNodeBounds(node);
+    if (YGNodeGetHasNewLayout(node) || child->GetBounds() != bounds) {
+      YGNodeSetHasNewLayout(node, false);
+      child->SetBounds(bounds);
+    } else {
+      ++skipped_bounds_count_;
+    }
+    // A child container that requested layout but kept its size would not
+    // update its children from SetBounds.
+    if (child->IsContainer() && static_cast<Container*>(child)->dirty_)
+      static_cast<Container*>(child)->UpdateChildBounds();
   }
 }
 
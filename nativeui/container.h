@@ -40,6 +40,13 @@ class NATIVEUI_EXPORT Container : public View {
   void AddChildViewAt(scoped_refptr<View> view, int index);
   void RemoveChildView(View* view);
 
+  // Add multiple children with only one layout pass.
+  void AddChildViews(std::vector<scoped_refptr<View>> views);
+
+  // Batch changes to children, the layout is deferred until EndUpdate.
+  void BeginUpdate();
+  void EndUpdate();
+
   // Get children.
   int ChildCount() const { return static_cast<int>(children_.size()); }
   View* ChildAt(int index) const {
@@ -51,6 +58,26 @@ class NATIVEUI_EXPORT Container : public View {
   // Internal: Used by certain implementations to refresh layout.
   virtual void UpdateChildBounds();
 
+  // Internal: Number of children whose bounds were not re-applied because
+  // their layout did not change.
+  int skipped_bounds_count() const { return skipped_bounds_count_; }
+
+#if defined(OS_LINUX)
+  // Draw the container into a bitmap once and reuse it, until the container
+  // is resized or something inside needs to be repainted.
+  void SetRasterCache(bool enabled);
+  bool IsRasterCacheEnabled() const { return raster_cache_enabled_; }
+
+  // Internal: Return the cached bitmap if it is valid for |size|.
+  Canvas* GetRasterCache(const SizeF& size);
+  void SetRasterCacheBitmap(scoped_refptr<Canvas> canvas);
+  void DropRasterCache();
+
+  // Internal: Counters of raster cache usage.
+  int raster_cache_hits() const { return raster_cache_hits_; }
+  int raster_cache_misses() const { return raster_cache_misses_; }
+#endif
+
   // Events.
   Signal<void(Container*, Painter*, RectF)> on_draw;
 
@@ -71,11 +98,32 @@ class NATIVEUI_EXPORT Container : public View {
   void PlatformRemoveChildView(View* view);
 
  private:
+  // Whether the window defers layout to next paint.
+  bool IsLayoutDeferred() const;
+
+  // Whether this container or any of its ancestors is batching updates.
+  bool IsInBatchUpdate() const;
+
   // Relationships.
   std::vector<scoped_refptr<View>> children_;
 
   // Whether the container should update children's layout.
   bool dirty_ = false;
+
+  // Depth of BeginUpdate calls and whether a layout has been requested.
+  int update_depth_ = 0;
+  bool needs_layout_ = false;
+
+  // Counts the SetBounds calls saved by UpdateChildBounds.
+  int skipped_bounds_count_ = 0;
+
+#if defined(OS_LINUX)
+  // The cached bitmap of container's drawing.
+  bool raster_cache_enabled_ = false;
+  scoped_refptr<Canvas> raster_cache_;
+  int raster_cache_hits_ = 0;
+  int raster_cache_misses_ = 0;
+#endif
 };
 
 }  // namespace nu
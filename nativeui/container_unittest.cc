@@ -142,6 +142,66 @@ TEST_F(ContainerTest, RemoveAndAddBack) {
   EXPECT_EQ(container_->ChildCount(), 1);
 }
 
+TEST_F(ContainerTest, AddChildViews) {
+  int count = container_->layout_count();
+  container_->AddChildViews({new nu::Label, new nu::Label, new nu::Label});
+  EXPECT_EQ(container_->ChildCount(), 3);
+  EXPECT_EQ(container_->layout_count(), count + 1);
+}
+
+TEST_F(ContainerTest, BeginEndUpdate) {
+  int count = container_->layout_count();
+  container_->BeginUpdate();
+  container_->AddChildView(new nu::Label);
+  container_->AddChildView(new nu::Label);
+  container_->BeginUpdate();
+  container_->RemoveChildView(container_->ChildAt(0));
+  container_->EndUpdate();
+  EXPECT_EQ(container_->layout_count(), count);
+  container_->EndUpdate();
+  EXPECT_EQ(container_->ChildCount(), 1);
+  EXPECT_EQ(container_->layout_count(), count + 1);
+}
+
+TEST_F(ContainerTest, BeginEndUpdateInAncestor) {
+  scoped_refptr<TestContainer> child = new TestContainer;
+  container_->AddChildView(child);
+  int count = child->layout_count();
+  container_->BeginUpdate();
+  child->AddChildView(new nu::Label);
+  child->AddChildView(new nu::Label);
+  EXPECT_EQ(child->layout_count(), count);
+  container_->EndUpdate();
+  EXPECT_GT(child->layout_count(), count);
+}
+
+TEST_F(ContainerTest, AddChildViewsSkipsViewsWithParent) {
+  scoped_refptr<nu::Container> other = new nu::Container;
+  nu::Label* owned = new nu::Label;
+  other->AddChildView(owned);
+  nu::Label* label = new nu::Label;
+  container_->AddChildViews({label, owned, label});
+  EXPECT_EQ(container_->ChildCount(), 1);
+  EXPECT_EQ(owned->GetParent(), other.get());
+}
+
+TEST_F(ContainerTest, SkipUnchangedBounds) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  window_->SetVisible(true);
+  nu::Container* c1 = new nu::Container;
+  c1->SetStyle("flex", 1);
+  container_->AddChildView(c1);
+  nu::Container* c2 = new nu::Container;
+  c2->SetStyle("flex", 1);
+  container_->AddChildView(c2);
+  int skipped = container_->skipped_bounds_count();
+  container_->Layout();
+  EXPECT_EQ(container_->skipped_bounds_count(), skipped + 2);
+  c2->SetStyle("flex", 0, "height", 10);
+  EXPECT_EQ(c1->GetBounds(), nu::RectF(0, 0, 200, 390));
+  EXPECT_EQ(c2->GetBounds(), nu::RectF(0, 390, 200, 10));
+}
+
 TEST_F(ContainerTest, MoveBetweenContainers) {
   window_->SetContentSize(nu::SizeF(200, 400));
   window_->SetVisible(true);
@@ -174,3 +234,39 @@ TEST_F(ContainerTest, MoveBetweenContainers) {
   EXPECT_EQ(v1->GetBounds(), nu::RectF(0, 0, 200, 100));
   EXPECT_EQ(v2->GetBounds(), nu::RectF(0, 100, 200, 100));
 }
+
+TEST_F(ContainerTest, DeferredLayout) {
+  window_->SetContentSize(nu::SizeF(200, 400));
+  window_->SetVisible(true);
+  window_->SetLayoutDeferred(true);
+  int count = container_->layout_count();
+  nu::Container* c1 = new nu::Container;
+  c1->SetStyle("flex", 1);
+  container_->AddChildView(c1);
+  nu::Container* c2 = new nu::Container;
+  c2->SetStyle("flex", 1);
+  container_->AddChildView(c2);
+  c1->SetVisible(false);
+  EXPECT_EQ(container_->layout_count(), count);
+  c2->LayoutImmediately();
+  EXPECT_EQ(container_->layout_count(), count + 1);
+  EXPECT_EQ(c2->GetBounds(), nu::RectF(0, 0, 200, 400));
+}
+
+#if defined(OS_LINUX)
+TEST_F(ContainerTest, RasterCache) {
+  nu::Label* label = new nu::Label;
+  container_->AddChildView(label);
+  container_->SetRasterCache(true);
+  nu::SizeF size(100, 100);
+  EXPECT_EQ(container_->GetRasterCache(size), nullptr);
+  container_->SetRasterCacheBitmap(new nu::Canvas(size));
+  EXPECT_NE(container_->GetRasterCache(size), nullptr);
+  EXPECT_EQ(container_->GetRasterCache(nu::SizeF(50, 50)), nullptr);
+  EXPECT_EQ(container_->raster_cache_hits(), 1);
+  EXPECT_EQ(container_->raster_cache_misses(), 2);
+  container_->SetRasterCacheBitmap(new nu::Canvas(size));
+  label->SchedulePaint();
+  EXPECT_EQ(container_->GetRasterCache(size), nullptr);
+}
+#endif
@@ -29,6 +29,7 @@ AttributedText::AttributedText(const std::string& text, TextFormat format)
 void AttributedText::SetFormat(TextFormat format) {
   format_ = std::move(format);
   PlatformUpdateFormat();
+  ++revision_;
 }
 
 void AttributedText::SetFont(scoped_refptr<Font> font) {
@@ -39,6 +40,7 @@ void AttributedText::SetFontFor(scoped_refptr<Font> font, int start, int end) {
   if (RangeInvalid(start, end))
     return;
   PlatformSetFontFor(std::move(font), start, end);
+  ++revision_;
 }
 
 void AttributedText::SetColor(Color color) {
@@ -57,6 +59,11 @@ void AttributedText::Clear() {
   SetColor(attrs.color);
 }
 
+void AttributedText::SetText(const std::string& text) {
+  PlatformSetText(text);
+  ++revision_;
+}
+
 SizeF AttributedText::GetOneLineSize() const {
   return GetBoundsFor(SizeF(FLT_MAX, FLT_MAX)).size();
 }
@@ -44,6 +44,9 @@ class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
   SizeF GetOneLineSize() const;
   float GetOneLineHeight() const;
 
+  // Internal: Increased whenever a change may affect the size of text.
+  int revision() const { return revision_; }
+
   NativeAttributedText GetNative() const { return text_; }
 
  protected:
@@ -52,12 +55,14 @@ class NATIVEUI_EXPORT AttributedText : public base::RefCounted<AttributedText> {
  private:
   friend class base::RefCounted<AttributedText>;
 
+  void PlatformSetText(const std::string& text);
   void PlatformUpdateFormat();
   void PlatformSetFontFor(scoped_refptr<Font> font, int start, int end);
   void PlatformSetColorFor(Color color, int start, int end);
 
   NativeAttributedText text_;
   TextFormat format_;
+  int revision_ = 0;
 };
 
 }  // namespace nu
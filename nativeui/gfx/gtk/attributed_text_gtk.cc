@@ -133,7 +133,7 @@ RectF AttributedText::GetBoundsFor(const SizeF& size) const {
   return RectF(0, 0, width, height);
 }
 
-void AttributedText::SetText(const std::string& text) {
+void AttributedText::PlatformSetText(const std::string& text) {
   pango_layout_set_text(text_, text.c_str(), text.length());
 }
 
@@ -56,6 +56,8 @@ Image::~Image() {
   g_object_unref(image_);
   if (iter_)
     g_object_unref(iter_);
+  if (surface_)
+    cairo_surface_destroy(surface_);
 }
 
 bool Image::IsEmpty() const {
@@ -112,10 +114,30 @@ bool Image::WriteToFile(const std::string& format,
 void Image::AdvanceFrame() {
   GTimeVal time;
   g_get_current_time(&time);
-  if (iter_)
-    gdk_pixbuf_animation_iter_advance(iter_, &time);
-  else
+  if (iter_) {
+    // Keep the cached surface if the frame did not change.
+    if (!gdk_pixbuf_animation_iter_advance(iter_, &time))
+      return;
+  } else {
     iter_ = gdk_pixbuf_animation_get_iter(image_, &time);
+  }
+  if (surface_) {
+    cairo_surface_destroy(surface_);
+    surface_ = nullptr;
+  }
+}
+
+cairo_surface_t* Image::GetCairoSurface() const {
+  if (!surface_) {
+    GdkPixbuf* pixbuf = iter_ ?
+        gdk_pixbuf_animation_iter_get_pixbuf(iter_) :
+        gdk_pixbuf_animation_get_static_image(image_);
+    // Converting a pixbuf requires copying and premultiplying every pixel,
+    // so it is only done once for each frame.
+    surface_ = gdk_cairo_surface_create_from_pixbuf(pixbuf, 1, nullptr);
+    cairo_surface_set_device_scale(surface_, scale_factor_, scale_factor_);
+  }
+  return surface_;
 }
 
 }  // namespace nu
@@ -204,7 +204,6 @@ void PainterGtk::DrawImage(const Image* image, const RectF& rect) {
 
 void PainterGtk::DrawImageFromRect(const Image* image, const RectF& src,
                                    const RectF& dest) {
-  RectF ps = ScaleRect(src, image->GetScaleFactor());
   cairo_save(context_);
   // Clip the image to |dest|.
   cairo_translate(context_, dest.x(), dest.y());
@@ -212,16 +211,13 @@ void PainterGtk::DrawImageFromRect(const Image* image, const RectF& src,
   cairo_rectangle(context_, 0, 0, dest.width(), dest.height());
   cairo_clip(context_);
   // Scale if needed.
-  float x_scale = dest.width() / ps.width();
-  float y_scale = dest.height() / ps.height();
+  float x_scale = dest.width() / src.width();
+  float y_scale = dest.height() / src.height();
   if (x_scale != 1.0f || y_scale != 1.0f)
     cairo_scale(context_, x_scale, y_scale);
-  // Choose the correct image.
-  GdkPixbuf* pixbuf = image->iter() ?
-      gdk_pixbuf_animation_iter_get_pixbuf(image->iter()) :
-      gdk_pixbuf_animation_get_static_image(image->GetNative());
-  // Draw.
-  gdk_cairo_set_source_pixbuf(context_, pixbuf, -ps.x(), -ps.y());
+  // Draw, the surface's device scale maps the pixels to DIP.
+  cairo_set_source_surface(context_, image->GetCairoSurface(),
+                           -src.x(), -src.y());
   cairo_paint(context_);
   cairo_restore(context_);
 }
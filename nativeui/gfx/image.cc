@@ -4,9 +4,13 @@
 
 #include "nativeui/gfx/image.h"
 
+#include <memory>
+#include <utility>
+
 #include "base/files/file_path.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
+#include "nativeui/message_loop.h"
 
 #if defined(OS_WIN)
 #include "base/strings/string_util_win.h"
@@ -41,6 +45,22 @@ ScaleFactorPair kScaleFactorPairs[] = {
 Image::Image(NativeImage image, float scale_factor)
     : scale_factor_(scale_factor), image_(image) {}
 
+// static
+void Image::CreateFromPathAsync(const base::FilePath& path,
+                                std::function<void(Image*)> callback) {
+  // The image is only referenced after it is passed to the main thread.
+  auto image = std::make_shared<Image*>(nullptr);
+  MessageLoop::PostBackgroundTask(
+      [path, image]() {
+        *image = new Image(path);
+      },
+      [image, callback = std::move(callback)]() {
+        scoped_refptr<Image> ref(*image);
+        if (callback)
+          callback(ref.get());
+      });
+}
+
 // static
 float Image::GetScaleFactorFromFilePath(const base::FilePath& path) {
   base::FilePath::StringType name(path.BaseName().RemoveExtension().value());
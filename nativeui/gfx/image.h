@@ -5,6 +5,7 @@
 #ifndef NATIVEUI_GFX_IMAGE_H_
 #define NATIVEUI_GFX_IMAGE_H_
 
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -25,6 +26,7 @@
 
 #if defined(OS_LINUX)
 typedef struct _GdkPixbufAnimationIter GdkPixbufAnimationIter;
+typedef struct _cairo_surface cairo_surface_t;
 #endif
 
 namespace nu {
@@ -44,6 +46,11 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   // Create an image from memory.
   Image(const Buffer& buffer, float scale_factor);
 
+  // Read and decode the image from |path| on a background thread, and then
+  // pass it to |callback| on the main thread.
+  static void CreateFromPathAsync(const base::FilePath& path,
+                                  std::function<void(Image*)> callback);
+
   // Whether the image is empty.
   bool IsEmpty() const;
 
@@ -89,6 +96,11 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
 
   // Internal: Return current animation frame.
   GdkPixbufAnimationIter* iter() const { return iter_; }
+
+  // Internal: Return the cairo surface of current frame, which has the
+  // device scale set to the image's scale factor. The surface is cached until
+  // the frame changes.
+  cairo_surface_t* GetCairoSurface() const;
 #endif
 
  protected:
@@ -107,6 +119,8 @@ class NATIVEUI_EXPORT Image : public base::RefCounted<Image> {
   bool is_empty_ = false;
   // The animation frame.
   GdkPixbufAnimationIter* iter_ = nullptr;
+  // Cached surface of current frame.
+  mutable cairo_surface_t* surface_ = nullptr;
 #elif defined(OS_MAC)
   // The frame durations.
   std::vector<float> durations_;
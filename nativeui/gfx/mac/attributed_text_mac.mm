@@ -83,7 +83,7 @@ RectF AttributedText::GetBoundsFor(const SizeF& size) const {
   }
 }
 
-void AttributedText::SetText(const std::string& text) {
+void AttributedText::PlatformSetText(const std::string& text) {
   [[text_ mutableString] setString:base::SysUTF8ToNSString(text)];
 }
 
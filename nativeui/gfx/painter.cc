@@ -5,6 +5,7 @@
 #include "nativeui/gfx/painter.h"
 
 #include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/picture.h"
 
 namespace nu {
 
@@ -17,4 +18,10 @@ void Painter::DrawText(const std::string& str, const RectF& rect,
   DrawAttributedText(new AttributedText(str, attributes), rect);
 }
 
+void Painter::DrawPicture(Picture* picture) {
+  Save();
+  picture->Playback(this);
+  Restore();
+}
+
 }  // namespace nu
@@ -22,6 +22,7 @@ namespace nu {
 class AttributedText;
 class Canvas;
 class Image;
+class Picture;
 
 enum class BlendMode : int {
   Normal = 0,
@@ -132,6 +133,9 @@ class NATIVEUI_EXPORT Painter {
   virtual void DrawText(const std::string& text, const RectF& rect,
                         const TextAttributes& attributes);
 
+  // Replay the drawing commands recorded in |picture|.
+  void DrawPicture(Picture* picture);
+
   base::WeakPtr<Painter> GetWeakPtr() { return weak_factory_.GetWeakPtr(); }
 
  protected:
@@ -0,0 +1,141 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/picture.h"
+
+#include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+Picture::Picture() {}
+
+Picture::~Picture() {}
+
+void Picture::Playback(Painter* painter) const {
+  auto arg = args_.begin();
+  auto color = colors_.begin();
+  auto image = images_.begin();
+  auto canvas = canvases_.begin();
+  auto text = texts_.begin();
+  auto point = [&arg]() {
+    PointF p(arg[0], arg[1]);
+    arg += 2;
+    return p;
+  };
+  auto rect = [&arg]() {
+    RectF r(arg[0], arg[1], arg[2], arg[3]);
+    arg += 4;
+    return r;
+  };
+  for (Op op : ops_) {
+    switch (op) {
+      case Op::Save:
+        painter->Save();
+        break;
+      case Op::Restore:
+        painter->Restore();
+        break;
+      case Op::SetBlendMode:
+        painter->SetBlendMode(static_cast<BlendMode>(*arg++));
+        break;
+      case Op::BeginPath:
+        painter->BeginPath();
+        break;
+      case Op::ClosePath:
+        painter->ClosePath();
+        break;
+      case Op::MoveTo:
+        painter->MoveTo(point());
+        break;
+      case Op::LineTo:
+        painter->LineTo(point());
+        break;
+      case Op::BezierCurveTo: {
+        PointF cp1 = point();
+        PointF cp2 = point();
+        painter->BezierCurveTo(cp1, cp2, point());
+        break;
+      }
+      case Op::Arc: {
+        PointF p = point();
+        float radius = arg[0], sa = arg[1], ea = arg[2];
+        arg += 3;
+        painter->Arc(p, radius, sa, ea);
+        break;
+      }
+      case Op::Rect:
+        painter->Rect(rect());
+        break;
+      case Op::Clip:
+        painter->Clip();
+        break;
+      case Op::ClipRect:
+        painter->ClipRect(rect());
+        break;
+      case Op::Translate: {
+        PointF p = point();
+        painter->Translate(Vector2dF(p.x(), p.y()));
+        break;
+      }
+      case Op::Rotate:
+        painter->Rotate(*arg++);
+        break;
+      case Op::Scale: {
+        PointF p = point();
+        painter->Scale(Vector2dF(p.x(), p.y()));
+        break;
+      }
+      case Op::SetColor:
+        painter->SetColor(*color++);
+        break;
+      case Op::SetStrokeColor:
+        painter->SetStrokeColor(*color++);
+        break;
+      case Op::SetFillColor:
+        painter->SetFillColor(*color++);
+        break;
+      case Op::SetLineWidth:
+        painter->SetLineWidth(*arg++);
+        break;
+      case Op::Stroke:
+        painter->Stroke();
+        break;
+      case Op::Fill:
+        painter->Fill();
+        break;
+      case Op::Clear:
+        painter->Clear();
+        break;
+      case Op::StrokeRect:
+        painter->StrokeRect(rect());
+        break;
+      case Op::FillRect:
+        painter->FillRect(rect());
+        break;
+#if defined(OS_LINUX)
+      case Op::DrawPath:
+        painter->DrawPath();
+        break;
+#endif
+      case Op::DrawImageFromRect: {
+        RectF src = rect();
+        painter->DrawImageFromRect((image++)->get(), src, rect());
+        break;
+      }
+      case Op::DrawCanvasFromRect: {
+        RectF src = rect();
+        painter->DrawCanvasFromRect((canvas++)->get(), src, rect());
+        break;
+      }
+      case Op::DrawAttributedText:
+        painter->DrawAttributedText(*text++, rect());
+        break;
+    }
+  }
+}
+
+}  // namespace nu
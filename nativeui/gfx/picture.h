@@ -0,0 +1,86 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PICTURE_H_
+#define NATIVEUI_GFX_PICTURE_H_
+
+#include <stdint.h>
+
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/color.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+class AttributedText;
+class Canvas;
+class Image;
+class Painter;
+
+// An immutable list of drawing commands recorded by PictureRecorder.
+class NATIVEUI_EXPORT Picture : public base::RefCounted<Picture> {
+ public:
+  Picture();
+
+  // Replay the recorded commands on |painter|.
+  void Playback(Painter* painter) const;
+
+  // Return the number of recorded commands.
+  int GetCommandCount() const { return static_cast<int>(ops_.size()); }
+
+ protected:
+  virtual ~Picture();
+
+ private:
+  friend class base::RefCounted<Picture>;
+  friend class RecordingPainter;
+
+  enum class Op : uint8_t {
+    Save,
+    Restore,
+    SetBlendMode,
+    BeginPath,
+    ClosePath,
+    MoveTo,
+    LineTo,
+    BezierCurveTo,
+    Arc,
+    Rect,
+    Clip,
+    ClipRect,
+    Translate,
+    Rotate,
+    Scale,
+    SetColor,
+    SetStrokeColor,
+    SetFillColor,
+    SetLineWidth,
+    Stroke,
+    Fill,
+    Clear,
+    StrokeRect,
+    FillRect,
+#if defined(OS_LINUX)
+    DrawPath,
+#endif
+    DrawImageFromRect,
+    DrawCanvasFromRect,
+    DrawAttributedText,
+  };
+
+  // The commands, and the arguments of them stored in the order they are
+  // consumed.
+  std::vector<Op> ops_;
+  std::vector<float> args_;
+  std::vector<Color> colors_;
+  std::vector<scoped_refptr<const Image>> images_;
+  std::vector<scoped_refptr<Canvas>> canvases_;
+  std::vector<scoped_refptr<AttributedText>> texts_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PICTURE_H_
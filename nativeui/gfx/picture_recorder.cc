@@ -0,0 +1,212 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gfx/picture_recorder.h"
+
+#include <utility>
+
+#include "nativeui/gfx/attributed_text.h"
+#include "nativeui/gfx/canvas.h"
+#include "nativeui/gfx/image.h"
+#include "nativeui/gfx/painter.h"
+
+namespace nu {
+
+// A Painter that appends the calls to a Picture instead of drawing.
+class RecordingPainter : public Painter {
+ public:
+  RecordingPainter() : picture_(new Picture) {}
+  ~RecordingPainter() override {}
+
+  scoped_refptr<Picture> Finish() {
+    scoped_refptr<Picture> picture = std::move(picture_);
+    picture_ = new Picture;
+    return picture;
+  }
+
+  // Painter:
+  void Save() override {
+    Append(Picture::Op::Save);
+  }
+
+  void Restore() override {
+    Append(Picture::Op::Restore);
+  }
+
+  void SetBlendMode(BlendMode mode) override {
+    Append(Picture::Op::SetBlendMode);
+    picture_->args_.push_back(static_cast<float>(mode));
+  }
+
+  void BeginPath() override {
+    Append(Picture::Op::BeginPath);
+  }
+
+  void ClosePath() override {
+    Append(Picture::Op::ClosePath);
+  }
+
+  void MoveTo(const PointF& p) override {
+    Append(Picture::Op::MoveTo);
+    AppendPoint(p);
+  }
+
+  void LineTo(const PointF& p) override {
+    Append(Picture::Op::LineTo);
+    AppendPoint(p);
+  }
+
+  void BezierCurveTo(const PointF& cp1,
+                     const PointF& cp2,
+                     const PointF& ep) override {
+    Append(Picture::Op::BezierCurveTo);
+    AppendPoint(cp1);
+    AppendPoint(cp2);
+    AppendPoint(ep);
+  }
+
+  void Arc(const PointF& point, float radius, float sa, float ea) override {
+    Append(Picture::Op::Arc);
+    AppendPoint(point);
+    picture_->args_.insert(picture_->args_.end(), {radius, sa, ea});
+  }
+
+  void Rect(const RectF& rect) override {
+    Append(Picture::Op::Rect);
+    AppendRect(rect);
+  }
+
+  void Clip() override {
+    Append(Picture::Op::Clip);
+  }
+
+  void ClipRect(const RectF& rect) override {
+    Append(Picture::Op::ClipRect);
+    AppendRect(rect);
+  }
+
+  void Translate(const Vector2dF& offset) override {
+    Append(Picture::Op::Translate);
+    picture_->args_.insert(picture_->args_.end(), {offset.x(), offset.y()});
+  }
+
+  void Rotate(float angle) override {
+    Append(Picture::Op::Rotate);
+    picture_->args_.push_back(angle);
+  }
+
+  void Scale(const Vector2dF& scale) override {
+    Append(Picture::Op::Scale);
+    picture_->args_.insert(picture_->args_.end(), {scale.x(), scale.y()});
+  }
+
+  void SetColor(Color color) override {
+    Append(Picture::Op::SetColor);
+    picture_->colors_.push_back(color);
+  }
+
+  void SetStrokeColor(Color color) override {
+    Append(Picture::Op::SetStrokeColor);
+    picture_->colors_.push_back(color);
+  }
+
+  void SetFillColor(Color color) override {
+    Append(Picture::Op::SetFillColor);
+    picture_->colors_.push_back(color);
+  }
+
+  void SetLineWidth(float width) override {
+    Append(Picture::Op::SetLineWidth);
+    picture_->args_.push_back(width);
+  }
+
+  void Stroke() override {
+    Append(Picture::Op::Stroke);
+  }
+
+  void Fill() override {
+    Append(Picture::Op::Fill);
+  }
+
+  void Clear() override {
+    Append(Picture::Op::Clear);
+  }
+
+  void StrokeRect(const RectF& rect) override {
+    Append(Picture::Op::StrokeRect);
+    AppendRect(rect);
+  }
+
+  void FillRect(const RectF& rect) override {
+    Append(Picture::Op::FillRect);
+    AppendRect(rect);
+  }
+
+#if defined(OS_LINUX)
+  void DrawPath() override {
+    Append(Picture::Op::DrawPath);
+  }
+#endif
+
+  void DrawImage(const Image* image, const RectF& rect) override {
+    DrawImageFromRect(image, RectF(image->GetSize()), rect);
+  }
+
+  void DrawImageFromRect(const Image* image, const RectF& src,
+                         const RectF& dest) override {
+    Append(Picture::Op::DrawImageFromRect);
+    AppendRect(src);
+    AppendRect(dest);
+    picture_->images_.emplace_back(image);
+  }
+
+  void DrawCanvas(Canvas* canvas, const RectF& rect) override {
+    DrawCanvasFromRect(canvas, RectF(canvas->GetSize()), rect);
+  }
+
+  void DrawCanvasFromRect(Canvas* canvas, const RectF& src,
+                          const RectF& dest) override {
+    Append(Picture::Op::DrawCanvasFromRect);
+    AppendRect(src);
+    AppendRect(dest);
+    picture_->canvases_.emplace_back(canvas);
+  }
+
+  void DrawAttributedText(scoped_refptr<AttributedText> text,
+                          const RectF& rect) override {
+    Append(Picture::Op::DrawAttributedText);
+    AppendRect(rect);
+    picture_->texts_.push_back(std::move(text));
+  }
+
+ private:
+  void Append(Picture::Op op) {
+    picture_->ops_.push_back(op);
+  }
+
+  void AppendPoint(const PointF& p) {
+    picture_->args_.insert(picture_->args_.end(), {p.x(), p.y()});
+  }
+
+  void AppendRect(const RectF& r) {
+    picture_->args_.insert(picture_->args_.end(),
+                           {r.x(), r.y(), r.width(), r.height()});
+  }
+
+  scoped_refptr<Picture> picture_;
+};
+
+PictureRecorder::PictureRecorder() : painter_(new RecordingPainter) {}
+
+PictureRecorder::~PictureRecorder() {}
+
+Painter* PictureRecorder::GetPainter() {
+  return painter_.get();
+}
+
+scoped_refptr<Picture> PictureRecorder::FinishRecording() {
+  return painter_->Finish();
+}
+
+}  // namespace nu
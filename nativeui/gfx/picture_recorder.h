@@ -0,0 +1,41 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GFX_PICTURE_RECORDER_H_
+#define NATIVEUI_GFX_PICTURE_RECORDER_H_
+
+#include <memory>
+
+#include "base/memory/ref_counted.h"
+#include "nativeui/gfx/picture.h"
+
+namespace nu {
+
+class Painter;
+class RecordingPainter;
+
+// Records drawing commands into a Picture.
+class NATIVEUI_EXPORT PictureRecorder
+    : public base::RefCounted<PictureRecorder> {
+ public:
+  PictureRecorder();
+
+  // Return the Painter that records the drawing commands.
+  Painter* GetPainter();
+
+  // Return the recorded picture, and start a new recording.
+  scoped_refptr<Picture> FinishRecording();
+
+ protected:
+  virtual ~PictureRecorder();
+
+ private:
+  friend class base::RefCounted<PictureRecorder>;
+
+  std::unique_ptr<RecordingPainter> painter_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GFX_PICTURE_RECORDER_H_
@@ -83,7 +83,7 @@ RectF AttributedText::GetBoundsFor(const SizeF& size) const {
                rect.Width / scale_factor, rect.Height / scale_factor);
 }
 
-void AttributedText::SetText(const std::string& text) {
+void AttributedText::PlatformSetText(const std::string& text) {
   text_->text = base::UTF8ToWide(text);
 }
 
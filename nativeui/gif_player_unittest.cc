@@ -13,18 +13,19 @@ class GifPlayerTest : public testing::Test {
     gif_ = new nu::GifPlayer();
     base::FilePath exe_path;
     base::PathService::Get(base::FILE_EXE, &exe_path);
-    base::FilePath dir = exe_path.DirName().DirName().DirName()
-                                 .Append(FILE_PATH_LITERAL("nativeui"))
-                                 .Append(FILE_PATH_LITERAL("test"))
-                                 .Append(FILE_PATH_LITERAL("fixtures"));
+    dir_ = exe_path.DirName().DirName().DirName()
+                   .Append(FILE_PATH_LITERAL("nativeui"))
+                   .Append(FILE_PATH_LITERAL("test"))
+                   .Append(FILE_PATH_LITERAL("fixtures"));
     animated_img_ = new nu::Image(
-        dir.Append(FILE_PATH_LITERAL("animated.gif")));
+        dir_.Append(FILE_PATH_LITERAL("animated.gif")));
     static_img_ = new nu::Image(
-        dir.Append(FILE_PATH_LITERAL("static.png")));
+        dir_.Append(FILE_PATH_LITERAL("static.png")));
   }
 
   nu::Lifetime lifetime_;
   nu::State state_;
+  base::FilePath dir_;
   scoped_refptr<nu::GifPlayer> gif_;
   scoped_refptr<nu::Image> animated_img_;
   scoped_refptr<nu::Image> static_img_;
@@ -36,6 +37,20 @@ TEST_F(GifPlayerTest, NullImage) {
   EXPECT_FALSE(gif_->IsAnimating());
 }
 
+TEST_F(GifPlayerTest, CreateFromPathAsync) {
+  scoped_refptr<nu::Image> image;
+  nu::Image::CreateFromPathAsync(
+      dir_.Append(FILE_PATH_LITERAL("static.png")),
+      [&image](nu::Image* result) {
+        image = result;
+        nu::MessageLoop::Quit();
+      });
+  nu::MessageLoop::Run();
+  ASSERT_TRUE(image);
+  EXPECT_FALSE(image->IsEmpty());
+  EXPECT_EQ(image->GetSize(), static_img_->GetSize());
+}
+
 TEST_F(GifPlayerTest, StaticImage) {
   gif_->SetImage(static_img_.get());
   EXPECT_FALSE(gif_->IsAnimating());
@@ -73,3 +88,14 @@ TEST_F(GifPlayerTest, HiddenView) {
   EXPECT_TRUE(gif_->IsPlaying());
 }
 #endif
+
+#if defined(OS_LINUX)
+TEST_F(GifPlayerTest, CachedCairoSurface) {
+  cairo_surface_t* surface = static_img_->GetCairoSurface();
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(100, 100));
+  for (int i = 0; i < 100; ++i)
+    canvas->GetPainter()->DrawImage(static_img_.get(),
+                                    nu::RectF(0, 0, 100, 100));
+  EXPECT_EQ(static_img_->GetCairoSurface(), surface);
+}
+#endif
@@ -6,6 +6,9 @@
 
 #include <gtk/gtk.h>
 
+#include <utility>
+
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gtk/nu_container.h"
 
 namespace nu {
@@ -56,11 +59,39 @@ void Container::PlatformAddChildView(View* child) {
     }
   }
 
+  InvalidateRasterCache();
   gtk_container_add(GTK_CONTAINER(GetNative()), child->GetNative());
 }
 
 void Container::PlatformRemoveChildView(View* child) {
+  InvalidateRasterCache();
   gtk_container_remove(GTK_CONTAINER(GetNative()), child->GetNative());
 }
 
+void Container::SetRasterCache(bool enabled) {
+  if (raster_cache_enabled_ == enabled)
+    return;
+  raster_cache_enabled_ = enabled;
+  raster_cache_ = nullptr;
+  nu_container_watch_invalidation(NU_CONTAINER(GetNative()), enabled);
+  gtk_widget_queue_draw(GetNative());
+}
+
+Canvas* Container::GetRasterCache(const SizeF& size) {
+  if (raster_cache_ && raster_cache_->GetSize() == size) {
+    ++raster_cache_hits_;
+    return raster_cache_.get();
+  }
+  ++raster_cache_misses_;
+  return nullptr;
+}
+
+void Container::SetRasterCacheBitmap(scoped_refptr<Canvas> canvas) {
+  raster_cache_ = std::move(canvas);
+}
+
+void Container::DropRasterCache() {
+  raster_cache_ = nullptr;
+}
+
 }  // namespace nu
@@ -5,16 +5,231 @@
 #include "nativeui/message_loop.h"
 
 #include <gtk/gtk.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
 
-#include "nativeui/gtk/util/widget_util.h"
+#include <algorithm>
+#include <atomic>
+#include <tuple>
+#include <utility>
+
+#include "base/logging.h"
+#include "base/posix/eintr_wrapper.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/util/timer_wheel.h"
 
 namespace nu {
 
 namespace {
 
-gboolean OnSource(MessageLoop::Task* func) {
-  (*func)();
-  return G_SOURCE_REMOVE;
+// Stop running tasks in one dispatch after this time, so posting lots of
+// tasks does not block input and painting.
+constexpr gint64 kMaxDispatchTimeUs = 8000;
+
+// Tasks posted from all threads are pushed to a lock-free stack, and the main
+// thread takes the whole stack at once in a single GSource which is woken up
+// by an eventfd. Only the first task pushed to an empty stack wakes up the
+// main loop.
+class TaskQueue {
+ public:
+  TaskQueue() : fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+    PCHECK(fd_ >= 0) << "Failed to create eventfd";
+    static GSourceFuncs funcs = {&TaskQueue::Prepare, nullptr,
+                                 &TaskQueue::Dispatch, nullptr};
+    source_ = static_cast<Source*>(g_source_new(&funcs, sizeof(Source)));
+    source_->queue = this;
+    g_source_add_unix_fd(source_, fd_, G_IO_IN);
+    // Tasks may run nested message loops, which should still run tasks.
+    g_source_set_can_recurse(source_, true);
+    g_source_attach(source_, nullptr);
+  }
+
+  TaskQueue(const TaskQueue&) = delete;
+  TaskQueue& operator=(const TaskQueue&) = delete;
+
+  void Push(MessageLoop::Task task) {
+    Node* node = new Node{std::move(task),
+                          incoming_.load(std::memory_order_relaxed)};
+    while (!incoming_.compare_exchange_weak(node->next, node,
+                                            std::memory_order_release,
+                                            std::memory_order_relaxed)) {}
+    if (!node->next) {
+      uint64_t value = 1;
+      std::ignore = HANDLE_EINTR(write(fd_, &value, sizeof(value)));
+    }
+  }
+
+ private:
+  struct Node {
+    MessageLoop::Task task;
+    Node* next;
+  };
+
+  struct Source : GSource {
+    TaskQueue* queue;
+  };
+
+  static gboolean Prepare(GSource* source, gint* timeout) {
+    *timeout = -1;
+    // Continue immediately when tasks were left by the last dispatch.
+    return static_cast<Source*>(source)->queue->pending_ != nullptr;
+  }
+
+  static gboolean Dispatch(GSource* source, GSourceFunc, gpointer) {
+    static_cast<Source*>(source)->queue->RunTasks();
+    return G_SOURCE_CONTINUE;
+  }
+
+  void RunTasks() {
+    // Reset the eventfd before taking tasks, so tasks pushed after the take
+    // will wake up the loop again.
+    uint64_t value;
+    std::ignore = HANDLE_EINTR(read(fd_, &value, sizeof(value)));
+    // The stack is in reverse order of posting, append it to pending tasks.
+    Node* taken = incoming_.exchange(nullptr, std::memory_order_acquire);
+    Node* reversed = nullptr;
+    Node* last = taken;
+    while (taken) {
+      Node* next = taken->next;
+      taken->next = reversed;
+      reversed = taken;
+      taken = next;
+    }
+    if (reversed) {
+      if (pending_tail_)
+        pending_tail_->next = reversed;
+      else
+        pending_ = reversed;
+      pending_tail_ = last;
+    }
+    // Run tasks until the time budget is used up.
+    gint64 deadline = g_get_monotonic_time() + kMaxDispatchTimeUs;
+    while (pending_) {
+      // Take the node before running the task, since the task may run a
+      // nested message loop that dispatches again.
+      Node* node = pending_;
+      pending_ = node->next;
+      if (!pending_)
+        pending_tail_ = nullptr;
+      node->task();
+      delete node;
+      if (g_get_monotonic_time() > deadline)
+        break;
+    }
+  }
+
+  const int fd_;
+  Source* source_;
+
+  // Pushed by any thread.
+  std::atomic<Node*> incoming_{nullptr};
+  // Tasks taken from the stack but not run yet, only accessed on main thread.
+  Node* pending_ = nullptr;
+  Node* pending_tail_ = nullptr;
+};
+
+TaskQueue* GetTaskQueue() {
+  static TaskQueue* queue = new TaskQueue;
+  return queue;
+}
+
+// Return current time in the 1ms ticks used by TimerWheel.
+uint64_t GetNowTick() {
+  return g_get_monotonic_time() / 1000;
+}
+
+// All timeouts are kept in a timer wheel, and run by a single GSource which
+// wakes up when the wheel needs to be advanced. Timers expiring in the same
+// millisecond run in one dispatch.
+class TimerSource {
+ public:
+  TimerSource() : wheel_(GetNowTick()) {
+    static GSourceFuncs funcs = {nullptr, nullptr,
+                                 &TimerSource::Dispatch, nullptr};
+    source_ = static_cast<Source*>(g_source_new(&funcs, sizeof(Source)));
+    source_->timers = this;
+    // Timers may run nested message loops, which should still run timers.
+    g_source_set_can_recurse(source_, true);
+    g_source_attach(source_, nullptr);
+  }
+
+  TimerSource(const TimerSource&) = delete;
+  TimerSource& operator=(const TimerSource&) = delete;
+
+  MessageLoop::TimerId SetTimeout(int ms, MessageLoop::Task task) {
+    base::AutoLock auto_lock(lock_);
+    // Round up current time so the timer never runs earlier than |ms|.
+    uint64_t expiry = (g_get_monotonic_time() + 999) / 1000 + std::max(ms, 0);
+    MessageLoop::TimerId id = wheel_.Add(expiry, std::move(task));
+    // A new timer can only make the source wake up earlier.
+    if (!has_ready_tick_ || expiry < ready_tick_)
+      SetReadyTick(expiry);
+    return id;
+  }
+
+  void ClearTimeout(MessageLoop::TimerId id) {
+    // Destroy the task after releasing lock, since destructors of its bound
+    // objects may add or clear timers.
+    MessageLoop::Task task;
+    // The source may wake up for nothing, which is cheaper than finding the
+    // next tick for every cancellation.
+    base::AutoLock auto_lock(lock_);
+    wheel_.Cancel(id, &task);
+  }
+
+ private:
+  struct Source : GSource {
+    TimerSource* timers;
+  };
+
+  static gboolean Dispatch(GSource* source, GSourceFunc, gpointer) {
+    static_cast<Source*>(source)->timers->RunTimers();
+    return G_SOURCE_CONTINUE;
+  }
+
+  void RunTimers() {
+    {
+      base::AutoLock auto_lock(lock_);
+      wheel_.Advance(GetNowTick());
+    }
+    // Tasks run and get destroyed without lock since they may add or clear
+    // timers.
+    while (true) {
+      MessageLoop::Task task;
+      {
+        base::AutoLock auto_lock(lock_);
+        if (!wheel_.PopExpired(&task))
+          break;
+      }
+      task();
+    }
+    base::AutoLock auto_lock(lock_);
+    uint64_t tick;
+    if (wheel_.GetNextTick(&tick)) {
+      SetReadyTick(tick);
+    } else {
+      has_ready_tick_ = false;
+      g_source_set_ready_time(source_, -1);
+    }
+  }
+
+  void SetReadyTick(uint64_t tick) {
+    has_ready_tick_ = true;
+    ready_tick_ = tick;
+    g_source_set_ready_time(source_, tick * 1000);
+  }
+
+  Source* source_;
+
+  base::Lock lock_;
+  TimerWheel wheel_;
+  bool has_ready_tick_ = false;
+  uint64_t ready_tick_ = 0;
+};
+
+TimerSource* GetTimerSource() {
+  static TimerSource* timers = new TimerSource;
+  return timers;
 }
 
 }  // namespace
@@ -31,8 +246,7 @@ void MessageLoop::Quit() {
 
 // static
 void MessageLoop::PostTask(Task task) {
-  g_idle_add_full(G_PRIORITY_DEFAULT, reinterpret_cast<GSourceFunc>(OnSource),
-                  new Task(std::move(task)), Delete<Task>);
+  GetTaskQueue()->Push(std::move(task));
 }
 
 // static
@@ -42,14 +256,12 @@ void MessageLoop::PostDelayedTask(int ms, Task task) {
 
 // static
 MessageLoop::TimerId MessageLoop::SetTimeout(int ms, Task task) {
-  return g_timeout_add_full(G_PRIORITY_DEFAULT, ms,
-                            reinterpret_cast<GSourceFunc>(OnSource),
-                            new Task(std::move(task)), Delete<Task>);
+  return GetTimerSource()->SetTimeout(ms, std::move(task));
 }
 
 // static
 void MessageLoop::ClearTimeout(TimerId id) {
-  g_source_remove(id);
+  GetTimerSource()->ClearTimeout(id);
 }
 
 }  // namespace nu
@@ -4,7 +4,10 @@
 
 #include "nativeui/gtk/nu_container.h"
 
+#include <set>
+
 #include "nativeui/container.h"
+#include "nativeui/gfx/canvas.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
 
 namespace nu {
@@ -13,6 +16,8 @@ struct _NUContainerPrivate {
   Container* delegate;
   GdkWindow* event_window;
   gint event_mask;
+  // The toplevel window whose invalidations drop the raster cache.
+  GdkWindow* invalidation_window;
 };
 
 namespace {
@@ -45,6 +50,102 @@ void DestroyEventWindow(GtkWidget* widget, NUContainerPrivate* priv) {
   priv->event_window = nullptr;
 }
 
+// The containers with raster cache in a toplevel window, stored on the
+// GdkWindow.
+const char kRasterCachesKey[] = "nu-raster-caches";
+using RasterCaches = std::set<Container*>;
+
+void DeleteRasterCaches(gpointer data) {
+  delete static_cast<RasterCaches*>(data);
+}
+
+// Whether |region| of |toplevel| covers the area of |widget|.
+bool IsWidgetInRegion(GtkWidget* toplevel, GtkWidget* widget,
+                      const cairo_region_t* region) {
+  if (!gtk_widget_is_drawable(widget))
+    return false;
+  // The clip includes drawing outside the allocation like shadows.
+  GtkAllocation allocation, clip;
+  gtk_widget_get_allocation(widget, &allocation);
+  gtk_widget_get_clip(widget, &clip);
+  int x, y;
+  if (!gtk_widget_translate_coordinates(widget, toplevel,
+                                        clip.x - allocation.x,
+                                        clip.y - allocation.y,
+                                        &x, &y))
+    return false;
+  cairo_rectangle_int_t rect = {x, y, clip.width, clip.height};
+  return cairo_region_contains_rectangle(region, &rect) !=
+         CAIRO_REGION_OVERLAP_OUT;
+}
+
+// Whether |region| covers any view inside |container| that is not a
+// container. Native widgets like entries repaint themselves without calling
+// View::SchedulePaint, which can only be noticed from the invalidations.
+bool IsNativeChildInRegion(GtkWidget* toplevel, Container* container,
+                           const cairo_region_t* region) {
+  if (!IsWidgetInRegion(toplevel, container->GetNative(), region))
+    return false;
+  for (int i = 0; i < container->ChildCount(); ++i) {
+    View* child = container->ChildAt(i);
+    if (child->IsContainer() ?
+            IsNativeChildInRegion(toplevel, static_cast<Container*>(child),
+                                  region) :
+            IsWidgetInRegion(toplevel, child->GetNative(), region))
+      return true;
+  }
+  return false;
+}
+
+// Called whenever a region of the toplevel window is invalidated.
+void OnToplevelInvalidate(GdkWindow* window, cairo_region_t* region) {
+  auto* caches = static_cast<RasterCaches*>(
+      g_object_get_data(G_OBJECT(window), kRasterCachesKey));
+  GtkWidget* toplevel = nullptr;
+  gdk_window_get_user_data(window, reinterpret_cast<gpointer*>(&toplevel));
+  if (!caches || !toplevel)
+    return;
+  for (Container* container : *caches) {
+    if (IsNativeChildInRegion(toplevel, container, region))
+      container->DropRasterCache();
+  }
+}
+
+// Drop the raster cache when native widgets inside are invalidated. The
+// handler is installed on the toplevel window, since the containers do not
+// have their own windows, and the windows of scroll views already have
+// handlers installed by GtkViewport.
+void WatchInvalidation(GtkWidget* widget, NUContainerPrivate* priv) {
+  if (priv->invalidation_window)
+    return;
+  GtkWidget* toplevel = gtk_widget_get_toplevel(widget);
+  if (!gtk_widget_is_toplevel(toplevel) || !gtk_widget_get_realized(toplevel))
+    return;
+  GdkWindow* window = gtk_widget_get_window(toplevel);
+  auto* caches = static_cast<RasterCaches*>(
+      g_object_get_data(G_OBJECT(window), kRasterCachesKey));
+  if (!caches) {
+    caches = new RasterCaches;
+    g_object_set_data_full(G_OBJECT(window), kRasterCachesKey, caches,
+                           DeleteRasterCaches);
+    gdk_window_set_invalidate_handler(window, OnToplevelInvalidate);
+  }
+  caches->insert(priv->delegate);
+  priv->invalidation_window = GDK_WINDOW(g_object_ref(window));
+}
+
+void UnwatchInvalidation(NUContainerPrivate* priv) {
+  if (!priv->invalidation_window)
+    return;
+  auto* caches = static_cast<RasterCaches*>(
+      g_object_get_data(G_OBJECT(priv->invalidation_window),
+                        kRasterCachesKey));
+  if (caches)
+    caches->erase(priv->delegate);
+  g_object_unref(priv->invalidation_window);
+  priv->invalidation_window = nullptr;
+}
+
 }  // namespace
 
 static void nu_container_realize(GtkWidget* widget);
@@ -96,10 +197,14 @@ static void nu_container_class_init(NUContainerClass* nu_class) {
 
 static void nu_container_realize(GtkWidget* widget) {
   GTK_WIDGET_CLASS(nu_container_parent_class)->realize(widget);
-  CreateEventWindow(widget, NU_CONTAINER(widget)->priv);
+  NUContainerPrivate* priv = NU_CONTAINER(widget)->priv;
+  CreateEventWindow(widget, priv);
+  if (priv->delegate->IsRasterCacheEnabled())
+    WatchInvalidation(widget, priv);
 }
 
 static void nu_container_unrealize(GtkWidget* widget) {
+  UnwatchInvalidation(NU_CONTAINER(widget)->priv);
   DestroyEventWindow(widget, NU_CONTAINER(widget)->priv);
   GTK_WIDGET_CLASS(nu_container_parent_class)->unrealize(widget);
 }
@@ -157,7 +262,9 @@ static void nu_container_style_updated(GtkWidget* widget) {
   GTK_WIDGET_CLASS(nu_container_parent_class)->style_updated(widget);
 }
 
-static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
+// Draw background, custom drawing and children in |dirty|.
+static void nu_container_draw_content(GtkWidget* widget, cairo_t* cr,
+                                      const RectF& dirty) {
   int width = gtk_widget_get_allocated_width(widget);
   int height = gtk_widget_get_allocated_height(widget);
   gtk_render_background(gtk_widget_get_style_context(widget), cr,
@@ -165,11 +272,52 @@ static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
 
   Container* delegate = NU_CONTAINER(widget)->priv->delegate;
   PainterGtk painter(cr, SizeF(width, height));
-  delegate->on_draw.Emit(delegate, &painter, nu::RectF(0, 0, width, height));
+  delegate->on_draw.Emit(delegate, &painter, dirty);
 
-  for (int i = 0; i < delegate->ChildCount(); ++i)
-    gtk_container_propagate_draw(GTK_CONTAINER(widget),
-                                 delegate->ChildAt(i)->GetNative(), cr);
+  // Children's allocations are relative to the parent window, while the
+  // cairo context is relative to the container.
+  GtkAllocation allocation;
+  gtk_widget_get_allocation(widget, &allocation);
+  for (int i = 0; i < delegate->ChildCount(); ++i) {
+    GtkWidget* child = delegate->ChildAt(i)->GetNative();
+    // The clip includes drawing outside the allocation like shadows.
+    GtkAllocation clip;
+    gtk_widget_get_clip(child, &clip);
+    RectF child_rect(clip.x - allocation.x, clip.y - allocation.y,
+                     clip.width, clip.height);
+    if (!child_rect.Intersects(dirty))
+      continue;
+    gtk_container_propagate_draw(GTK_CONTAINER(widget), child, cr);
+  }
+}
+
+static gboolean nu_container_draw(GtkWidget* widget, cairo_t* cr) {
+  int width = gtk_widget_get_allocated_width(widget);
+  int height = gtk_widget_get_allocated_height(widget);
+
+  Container* delegate = NU_CONTAINER(widget)->priv->delegate;
+  if (!delegate->IsRasterCacheEnabled()) {
+    // Only the clipped area needs to be redrawn.
+    double x1, y1, x2, y2;
+    cairo_clip_extents(cr, &x1, &y1, &x2, &y2);
+    RectF dirty(x1, y1, x2 - x1, y2 - y1);
+    dirty.Intersect(RectF(0, 0, width, height));
+    nu_container_draw_content(widget, cr, dirty);
+    return FALSE;
+  }
+
+  // Draw everything into the cached bitmap, and then copy from it.
+  SizeF size(width, height);
+  scoped_refptr<Canvas> canvas = delegate->GetRasterCache(size);
+  if (!canvas) {
+    canvas = new Canvas(size, gtk_widget_get_scale_factor(widget));
+    cairo_t* context = cairo_create(canvas->GetBitmap());
+    nu_container_draw_content(widget, context, RectF(size));
+    cairo_destroy(context);
+    delegate->SetRasterCacheBitmap(canvas);
+  }
+  cairo_set_source_surface(cr, canvas->GetBitmap(), 0, 0);
+  cairo_paint(cr);
   return FALSE;
 }
 
@@ -206,6 +354,7 @@ GtkWidget* nu_container_new(Container* delegate) {
   priv->delegate = delegate;
   priv->event_window = nullptr;
   priv->event_mask = 0;
+  priv->invalidation_window = nullptr;
   return GTK_WIDGET(widget);
 }
 
@@ -224,4 +373,12 @@ void nu_container_add_event_mask(NUContainer* container, gint event_mask) {
     CreateEventWindow(widget, container->priv);
 }
 
+void nu_container_watch_invalidation(NUContainer* container, gboolean watch) {
+  GtkWidget* widget = GTK_WIDGET(container);
+  if (!watch)
+    UnwatchInvalidation(container->priv);
+  else if (gtk_widget_get_realized(widget))
+    WatchInvalidation(widget, container->priv);
+}
+
 }  // namespace nu
@@ -36,6 +36,7 @@ GType nu_container_get_type();
 GtkWidget* nu_container_new(Container* delegate);
 GdkWindow* nu_container_get_window(NUContainer* widget);
 void nu_container_add_event_mask(NUContainer* widget, gint event_mask);
+void nu_container_watch_invalidation(NUContainer* widget, gboolean watch);
 
 }  // namespace nu
 
@@ -0,0 +1,69 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/gtk/table/cell_raster_cache.h"
+
+#include <iterator>
+#include <limits>
+
+namespace nu {
+
+CellRasterCache::CellRasterCache(size_t budget) : budget_(budget) {}
+
+CellRasterCache::~CellRasterCache() {
+  Clear();
+}
+
+cairo_surface_t* CellRasterCache::Get(int row, int width, int height,
+                                      int scale) {
+  auto it = index_.find(Key(row, width, height, scale));
+  if (it == index_.end())
+    return nullptr;
+  if (it->second != entries_.begin())
+    entries_.splice(entries_.begin(), entries_, it->second);
+  return it->second->surface;
+}
+
+void CellRasterCache::Put(int row, int width, int height, int scale,
+                          cairo_surface_t* surface) {
+  size_t bytes = static_cast<size_t>(
+      cairo_image_surface_get_stride(surface) *
+      cairo_image_surface_get_height(surface));
+  if (bytes > budget_)
+    return;
+  Key key(row, width, height, scale);
+  auto it = index_.find(key);
+  if (it != index_.end())
+    Erase(it->second);
+  while (size_ + bytes > budget_)
+    Erase(std::prev(entries_.end()));
+  entries_.push_front({key, cairo_surface_reference(surface), bytes});
+  index_[key] = entries_.begin();
+  size_ += bytes;
+}
+
+void CellRasterCache::Invalidate(int start, int end) {
+  auto it = index_.lower_bound(Key(start, std::numeric_limits<int>::min(),
+                                   std::numeric_limits<int>::min(),
+                                   std::numeric_limits<int>::min()));
+  while (it != index_.end() && std::get<0>(it->first) < end)
+    Erase((it++)->second);
+}
+
+void CellRasterCache::Clear() {
+  for (Entry& entry : entries_)
+    cairo_surface_destroy(entry.surface);
+  entries_.clear();
+  index_.clear();
+  size_ = 0;
+}
+
+void CellRasterCache::Erase(std::list<Entry>::iterator it) {
+  cairo_surface_destroy(it->surface);
+  size_ -= it->bytes;
+  index_.erase(it->key);
+  entries_.erase(it);
+}
+
+}  // namespace nu
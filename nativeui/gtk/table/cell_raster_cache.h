@@ -0,0 +1,65 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_GTK_TABLE_CELL_RASTER_CACHE_H_
+#define NATIVEUI_GTK_TABLE_CELL_RASTER_CACHE_H_
+
+#include <cairo.h>
+
+#include <list>
+#include <map>
+#include <tuple>
+
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Keeps the rendered surfaces of table cells in a column, the least recently
+// used ones are dropped when the memory used exceeds the budget.
+class NATIVEUI_EXPORT CellRasterCache {
+ public:
+  explicit CellRasterCache(size_t budget);
+  ~CellRasterCache();
+
+  CellRasterCache(const CellRasterCache&) = delete;
+  CellRasterCache& operator=(const CellRasterCache&) = delete;
+
+  // Return the surface rendered for |row| with the size and scale factor, the
+  // surface is owned by the cache.
+  cairo_surface_t* Get(int row, int width, int height, int scale);
+
+  // Store the |surface|, a reference is taken by the cache.
+  void Put(int row, int width, int height, int scale, cairo_surface_t* surface);
+
+  // Drop the surfaces of rows in [start, end).
+  void Invalidate(int start, int end);
+  void Clear();
+
+  size_t budget() const { return budget_; }
+  size_t size() const { return size_; }
+  size_t count() const { return entries_.size(); }
+
+ private:
+  // (row, width, height, scale)
+  using Key = std::tuple<int, int, int, int>;
+
+  struct Entry {
+    Key key;
+    cairo_surface_t* surface;
+    size_t bytes;
+  };
+
+  void Erase(std::list<Entry>::iterator it);
+
+  const size_t budget_;
+  size_t size_ = 0;
+
+  // Most recently used first.
+  std::list<Entry> entries_;
+  std::map<Key, std::list<Entry>::iterator> index_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_GTK_TABLE_CELL_RASTER_CACHE_H_
@@ -4,10 +4,13 @@
 
 #include "nativeui/gtk/table/nu_custom_cell_renderer.h"
 
+#include <memory>
 #include <utility>
 
 #include "base/values.h"
 #include "nativeui/gfx/gtk/painter_gtk.h"
+#include "nativeui/gtk/table/cell_raster_cache.h"
+#include "nativeui/gtk/table/nu_tree_model.h"
 
 namespace nu {
 
@@ -16,6 +19,13 @@ enum { PROP_VALUE = 1 };
 struct _NUCustomCellRendererPrivate {
   Table::ColumnOptions options;
   base::Value value;
+  // Points to either |value| or a value borrowed from model.
+  const base::Value* value_ref;
+  // When raster cache is enabled, the value is only read from model when the
+  // cell is not cached.
+  std::unique_ptr<CellRasterCache> cache;
+  GtkTreeModel* tree_model;
+  int row;
 };
 
 static void nu_custom_cell_renderer_class_init(
@@ -38,6 +48,11 @@ static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
                                            const GdkRectangle* background_area,
                                            const GdkRectangle* cell_area,
                                            GtkCellRendererState flags);
+static void nu_custom_cell_renderer_render_cached(
+    GtkCellRenderer* cell,
+    cairo_t* cr,
+    GtkWidget* widget,
+    const GdkRectangle* cell_area);
 
 G_DEFINE_TYPE_WITH_PRIVATE(NUCustomCellRenderer,
                            nu_custom_cell_renderer,
@@ -65,6 +80,7 @@ static void nu_custom_cell_renderer_finalize(GObject* object) {
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   priv->options.Table::ColumnOptions::~ColumnOptions();
   priv->value.base::Value::~Value();
+  priv->cache.std::unique_ptr<CellRasterCache>::~unique_ptr();
 
   G_OBJECT_CLASS(nu_custom_cell_renderer_parent_class)->finalize(object);
 }
@@ -83,6 +99,8 @@ static void nu_custom_cell_renderer_set_property(GObject* object,
     priv->value = base::Value(std::move(*value));
   else
     priv->value = base::Value();
+  priv->value_ref = &priv->value;
+  priv->tree_model = nullptr;
 }
 
 static void nu_custom_cell_renderer_get_size(GtkCellRenderer* renderer,
@@ -116,10 +134,57 @@ static void nu_custom_cell_renderer_render(GtkCellRenderer* cell,
   cairo_rectangle(cr, 0, 0, cell_area->width, cell_area->height);
   cairo_clip(cr);
 
+  if (priv->cache && priv->tree_model) {
+    nu_custom_cell_renderer_render_cached(cell, cr, widget, cell_area);
+    return;
+  }
+
   PainterGtk painter(cr, SizeF(cell_area->width, cell_area->height));
   priv->options.on_draw(&painter,
                         nu::RectF(0, 0, cell_area->width, cell_area->height),
-                        priv->value);
+                        *priv->value_ref);
+}
+
+static void nu_custom_cell_renderer_render_cached(
+    GtkCellRenderer* cell,
+    cairo_t* cr,
+    GtkWidget* widget,
+    const GdkRectangle* cell_area) {
+  NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(cell)->priv;
+  int scale = gtk_widget_get_scale_factor(widget);
+  cairo_surface_t* surface = priv->cache->Get(
+      priv->row, cell_area->width, cell_area->height, scale);
+  if (surface) {
+    cairo_set_source_surface(cr, surface, 0, 0);
+    cairo_paint(cr);
+    return;
+  }
+
+  // Only read the value when the cell has to be drawn.
+  base::Value buffer;
+  GtkTreeIter iter = {true, GINT_TO_POINTER(priv->row)};
+  gint column = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(cell), "column"));
+  const base::Value* value = nu_tree_model_peek_value(
+      NU_TREE_MODEL(priv->tree_model), &iter, column, &buffer);
+
+  surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32,
+                                       cell_area->width * scale,
+                                       cell_area->height * scale);
+  cairo_surface_set_device_scale(surface, scale, scale);
+  cairo_t* context = cairo_create(surface);
+  {
+    PainterGtk painter(context, SizeF(cell_area->width, cell_area->height));
+    priv->options.on_draw(&painter,
+                          nu::RectF(0, 0, cell_area->width, cell_area->height),
+                          *value);
+  }
+  cairo_destroy(context);
+
+  cairo_set_source_surface(cr, surface, 0, 0);
+  cairo_paint(cr);
+  priv->cache->Put(priv->row, cell_area->width, cell_area->height, scale,
+                   surface);
+  cairo_surface_destroy(surface);
 }
 
 static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
@@ -127,6 +192,10 @@ static void nu_custom_cell_renderer_init(NUCustomCellRenderer* cell) {
   cell->priv = static_cast<NUCustomCellRendererPrivate*>(
       nu_custom_cell_renderer_get_instance_private(cell));
   new(&cell->priv->value) base::Value();
+  new(&cell->priv->cache) std::unique_ptr<CellRasterCache>();
+  cell->priv->value_ref = &cell->priv->value;
+  cell->priv->tree_model = nullptr;
+  cell->priv->row = -1;
 }
 
 GtkCellRenderer* nu_custom_cell_renderer_new(
@@ -135,7 +204,33 @@ GtkCellRenderer* nu_custom_cell_renderer_new(
   // Do in-place new since memory has already been allocated.
   NUCustomCellRendererPrivate* priv = NU_CUSTOM_CELL_RENDERER(object)->priv;
   new(&priv->options) Table::ColumnOptions(options);
+  if (options.raster_cache_size > 0)
+    priv->cache = std::make_unique<CellRasterCache>(options.raster_cache_size);
   return GTK_CELL_RENDERER(object);
 }
 
+void nu_custom_cell_renderer_set_value_ref(NUCustomCellRenderer* renderer,
+                                           const base::Value* value) {
+  renderer->priv->value_ref = value;
+  renderer->priv->tree_model = nullptr;
+}
+
+bool nu_custom_cell_renderer_has_raster_cache(NUCustomCellRenderer* renderer) {
+  return !!renderer->priv->cache;
+}
+
+void nu_custom_cell_renderer_set_row(NUCustomCellRenderer* renderer,
+                                     GtkTreeModel* tree_model,
+                                     int row) {
+  renderer->priv->tree_model = tree_model;
+  renderer->priv->row = row;
+}
+
+void nu_custom_cell_renderer_invalidate(NUCustomCellRenderer* renderer,
+                                        int start,
+                                        int end) {
+  if (renderer->priv->cache)
+    renderer->priv->cache->Invalidate(start, end);
+}
+
 }  // namespace nu
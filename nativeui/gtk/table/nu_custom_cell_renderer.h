@@ -37,6 +37,23 @@ GType nu_custom_cell_renderer_get_type();
 GtkCellRenderer* nu_custom_cell_renderer_new(
     const Table::ColumnOptions& options);
 
+// Draw the cell with |value| owned by someone else, which must be alive until
+// the cell is rendered.
+void nu_custom_cell_renderer_set_value_ref(NUCustomCellRenderer* renderer,
+                                           const base::Value* value);
+
+// With raster cache, the renderer reads value of |row| from |tree_model| only
+// when the cell is not cached.
+bool nu_custom_cell_renderer_has_raster_cache(NUCustomCellRenderer* renderer);
+void nu_custom_cell_renderer_set_row(NUCustomCellRenderer* renderer,
+                                     GtkTreeModel* tree_model,
+                                     int row);
+
+// Drop cached cells of rows in [start, end).
+void nu_custom_cell_renderer_invalidate(NUCustomCellRenderer* renderer,
+                                        int start,
+                                        int end);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_TABLE_NU_CUSTOM_CELL_RENDERER_H_
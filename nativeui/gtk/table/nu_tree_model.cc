@@ -7,14 +7,24 @@
 #include "nativeui/gtk/table/nu_boxed_value.h"
 #include "nativeui/table.h"
 #include "nativeui/table_model.h"
+#include "nativeui/tree_table_model.h"
 
 namespace nu {
 
 struct _NUTreeModelPrivate {
   Table* table;
   TableModel* model;
+  // Set when the model shows a tree.
+  TreeTableModel* tree;
 };
 
+// Point |iter| to |row|, returns false for -1.
+static gboolean nu_tree_model_set_iter(GtkTreeIter* iter, int row) {
+  iter->stamp = row >= 0;
+  iter->user_data = GINT_TO_POINTER(row);
+  return row >= 0;
+}
+
 static void nu_tree_model_tree_model_init(GtkTreeModelIface* iface);
 static void nu_tree_model_finalize(GObject* obj);
 static GtkTreeModelFlags nu_tree_model_get_flags(GtkTreeModel* tree_model);
@@ -79,7 +89,9 @@ static void nu_tree_model_finalize(GObject* obj) {
 }
 
 static GtkTreeModelFlags nu_tree_model_get_flags(GtkTreeModel* tree_model) {
-  return GTK_TREE_MODEL_LIST_ONLY;
+  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
+  return priv->tree ? static_cast<GtkTreeModelFlags>(0)
+                    : GTK_TREE_MODEL_LIST_ONLY;
 }
 
 static gint nu_tree_model_get_n_columns(GtkTreeModel* tree_model) {
@@ -97,6 +109,19 @@ static gboolean nu_tree_model_get_iter(GtkTreeModel* tree_model,
                                        GtkTreePath* path) {
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   iter->stamp = false;
+  if (priv->tree) {
+    gint depth = 0;
+    gint* indices = gtk_tree_path_get_indices_with_depth(path, &depth);
+    int row = -1;
+    for (gint i = 0; i < depth; ++i) {
+      if (indices[i] < 0)
+        return false;
+      row = priv->tree->GetChildRow(row, indices[i]);
+      if (row < 0)
+        return false;
+    }
+    return nu_tree_model_set_iter(iter, row);
+  }
   if (gtk_tree_path_get_depth(path) != 1)
     return false;
   gint row = gtk_tree_path_get_indices(path)[0];
@@ -111,8 +136,14 @@ static GtkTreePath* nu_tree_model_get_path(GtkTreeModel* tree_model,
                                            GtkTreeIter* iter) {
   if (!iter->stamp)
     return nullptr;
+  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   gint row = GPOINTER_TO_INT(iter->user_data);
-  return gtk_tree_path_new_from_indices(row, -1);
+  if (!priv->tree)
+    return gtk_tree_path_new_from_indices(row, -1);
+  GtkTreePath* path = gtk_tree_path_new();
+  for (; row >= 0; row = priv->tree->GetParentRow(row))
+    gtk_tree_path_prepend_index(path, priv->tree->GetChildIndex(row));
+  return path;
 }
 
 static void nu_tree_model_get_value(GtkTreeModel* tree_model,
@@ -124,6 +155,9 @@ static void nu_tree_model_get_value(GtkTreeModel* tree_model,
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   gint row = GPOINTER_TO_INT(iter->user_data);
   g_value_init(value, NU_BOXED_VALUE);
+  // Callers of gtk_tree_model_get may keep the value after model changes, so
+  // always give them a copy. Only TreeCellData borrows values from model, see
+  // nu_tree_model_peek_value.
   g_value_take_boxed(value,
                      nu_boxed_value_new(priv->model->GetValue(column, row)));
 }
@@ -134,6 +168,8 @@ static gboolean nu_tree_model_iter_next(GtkTreeModel* tree_model,
     return false;
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   gint row = GPOINTER_TO_INT(iter->user_data);
+  if (priv->tree)
+    return nu_tree_model_set_iter(iter, priv->tree->GetNextSiblingRow(row));
   if (row + 1 >= static_cast<int>(priv->model->GetRowCount())) {
     iter->stamp = false;
     return false;
@@ -147,7 +183,14 @@ static gboolean nu_tree_model_iter_previous(GtkTreeModel* tree_model,
                                             GtkTreeIter* iter) {
   if (!iter->stamp)
     return false;
+  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   gint row = GPOINTER_TO_INT(iter->user_data);
+  if (priv->tree) {
+    uint32_t index = priv->tree->GetChildIndex(row);
+    return nu_tree_model_set_iter(
+        iter, index == 0 ? -1 : priv->tree->GetChildRow(
+                                    priv->tree->GetParentRow(row), index - 1));
+  }
   if (row - 1 < 0) {
     iter->stamp = false;
     return false;
@@ -163,15 +206,27 @@ static gboolean nu_tree_model_iter_children(GtkTreeModel* tree_model,
   return gtk_tree_model_iter_nth_child(tree_model, iter, parent, 0);
 }
 
+// Children of collapsed nodes are not loaded, so a node may have child while
+// not having any child iter. The table loads the children when the tree view
+// is about to expand the node.
 static gboolean nu_tree_model_iter_has_child(GtkTreeModel* tree_model,
                                              GtkTreeIter* iter) {
-  return false;
+  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
+  if (!priv->tree || !iter->stamp)
+    return false;
+  return priv->tree->IsExpandable(GPOINTER_TO_INT(iter->user_data));
 }
 
 static gint nu_tree_model_iter_n_children(GtkTreeModel* tree_model,
                                           GtkTreeIter* iter) {
   NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
-  return iter ? 0 : priv->table->GetColumnCount();
+  if (priv->tree) {
+    if (iter && !iter->stamp)
+      return 0;
+    return priv->tree->GetChildCount(
+        iter ? GPOINTER_TO_INT(iter->user_data) : -1);
+  }
+  return iter ? 0 : priv->model->GetRowCount();
 }
 
 static gboolean nu_tree_model_iter_nth_child(GtkTreeModel* tree_model,
@@ -179,9 +234,16 @@ static gboolean nu_tree_model_iter_nth_child(GtkTreeModel* tree_model,
                                              GtkTreeIter* parent,
                                              gint n) {
   iter->stamp = false;
+  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
+  if (priv->tree) {
+    if (n < 0 || (parent && !parent->stamp))
+      return false;
+    return nu_tree_model_set_iter(
+        iter, priv->tree->GetChildRow(
+                  parent ? GPOINTER_TO_INT(parent->user_data) : -1, n));
+  }
   if (parent)
     return false;
-  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
   if (n < 0 || static_cast<uint32_t>(n) >= priv->model->GetRowCount())
     return false;
   iter->stamp = true;
@@ -193,7 +255,11 @@ static gboolean nu_tree_model_iter_parent(GtkTreeModel* tree_model,
                                           GtkTreeIter* iter,
                                           GtkTreeIter* child) {
   iter->stamp = false;
-  return false;
+  NUTreeModelPrivate* priv = NU_TREE_MODEL(tree_model)->priv;
+  if (!priv->tree || !child->stamp)
+    return false;
+  return nu_tree_model_set_iter(
+      iter, priv->tree->GetParentRow(GPOINTER_TO_INT(child->user_data)));
 }
 
 static void nu_tree_model_init(NUTreeModel* tree_model) {
@@ -205,7 +271,27 @@ NUTreeModel* nu_tree_model_new(Table* table, TableModel* model) {
   void* obj = g_object_new(NU_TYPE_TREE_MODEL, nullptr);
   NU_TREE_MODEL(obj)->priv->table = table;
   NU_TREE_MODEL(obj)->priv->model = model;
+  NU_TREE_MODEL(obj)->priv->tree = model ? model->AsTreeTableModel() : nullptr;
   return NU_TREE_MODEL(obj);
 }
 
+TreeTableModel* nu_tree_model_get_tree(NUTreeModel* tree_model) {
+  return tree_model->priv->tree;
+}
+
+const base::Value* nu_tree_model_peek_value(NUTreeModel* tree_model,
+                                            GtkTreeIter* iter,
+                                            gint column,
+                                            base::Value* buffer) {
+  if (!iter->stamp)
+    return buffer;
+  TableModel* model = tree_model->priv->model;
+  gint row = GPOINTER_TO_INT(iter->user_data);
+  const base::Value* ref = model->GetValueRef(column, row);
+  if (ref)
+    return ref;
+  *buffer = model->GetValue(column, row);
+  return buffer;
+}
+
 }  // namespace nu
@@ -9,10 +9,15 @@
 
 // Custom tree model type for TableModel.
 
+namespace base {
+class Value;
+}
+
 namespace nu {
 
 class Table;
 class TableModel;
+class TreeTableModel;
 
 #define NU_TYPE_TREE_MODEL (nu_tree_model_get_type())
 #define NU_TREE_MODEL(obj) (G_TYPE_CHECK_INSTANCE_CAST((obj), \
@@ -36,6 +41,16 @@ struct _NUTreeModelClass {
 GType nu_tree_model_get_type();
 NUTreeModel* nu_tree_model_new(Table* table, TableModel* model);
 
+// Return the model if it shows a tree, otherwise nullptr.
+TreeTableModel* nu_tree_model_get_tree(NUTreeModel* tree_model);
+
+// Return the value at |iter| without copying it when the model supports,
+// otherwise the value is stored in |buffer| and |buffer| is returned.
+const base::Value* nu_tree_model_peek_value(NUTreeModel* tree_model,
+                                            GtkTreeIter* iter,
+                                            gint column,
+                                            base::Value* buffer);
+
 }  // namespace nu
 
 #endif  // NATIVEUI_GTK_TABLE_NU_TREE_MODEL_H_
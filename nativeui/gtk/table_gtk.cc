@@ -4,6 +4,12 @@
 
 #include "nativeui/table.h"
 
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
 #include "base/logging.h"
 #include "base/notreached.h"
 #include "base/values.h"
@@ -11,11 +17,184 @@
 #include "nativeui/gtk/table/nu_tree_model.h"
 #include "nativeui/gtk/util/widget_util.h"
 #include "nativeui/table_model.h"
+#include "nativeui/table_search_index.h"
+#include "nativeui/tree_table_model.h"
 
 namespace nu {
 
 namespace {
 
+// When more rows than this are changed at once, the tree model is swapped
+// instead of emitting signals for each row, so the tree view only needs to
+// revalidate once.
+constexpr uint32_t kMaxRowSignals = 256;
+
+// Get the tree view of table.
+inline GtkTreeView* GetTreeView(const Table* table) {
+  return GTK_TREE_VIEW(g_object_get_data(G_OBJECT(table->GetNative()),
+                                         "widget"));
+}
+
+// Drop the cached rendering of custom cells in rows [start, end), -1 for
+// |column| means all columns.
+void InvalidateRasterCache(const std::vector<GtkCellRenderer*>& renderers,
+                           int column, int start,
+                           int end = std::numeric_limits<int>::max()) {
+  for (GtkCellRenderer* renderer : renderers) {
+    if (column != -1 && column != GPOINTER_TO_INT(
+            g_object_get_data(G_OBJECT(renderer), "column")))
+      continue;
+    nu_custom_cell_renderer_invalidate(NU_CUSTOM_CELL_RENDERER(renderer),
+                                       start, end);
+  }
+}
+
+// Return the model if the table shows a tree.
+TreeTableModel* GetTreeTableModel(Table* table) {
+  auto* tree_model = gtk_tree_view_get_model(GetTreeView(table));
+  if (!tree_model)
+    return nullptr;
+  return nu_tree_model_get_tree(NU_TREE_MODEL(tree_model));
+}
+
+// Translate between rows of model and paths of tree model.
+GtkTreePath* GetTreePath(GtkTreeModel* tree_model, uint32_t row) {
+  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+  return gtk_tree_model_get_path(tree_model, &iter);
+}
+
+int GetRowFromTreePath(GtkTreeModel* tree_model, GtkTreePath* path) {
+  GtkTreeIter iter;
+  if (!gtk_tree_model_get_iter(tree_model, &iter, path))
+    return -1;
+  return GPOINTER_TO_INT(iter.user_data);
+}
+
+// Emit row changes to the tree model of table.
+void EmitRowInserted(Table* table, uint32_t row) {
+  auto* tree_model = gtk_tree_view_get_model(GetTreeView(table));
+  if (!tree_model)
+    return;
+  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
+  gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
+  gtk_tree_path_free(tree_path);
+}
+
+void EmitRowDeleted(Table* table, uint32_t row) {
+  auto* tree_model = gtk_tree_view_get_model(GetTreeView(table));
+  if (!tree_model)
+    return;
+  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
+  gtk_tree_model_row_deleted(tree_model, tree_path);
+  gtk_tree_path_free(tree_path);
+}
+
+void EmitRowChanged(Table* table, uint32_t row) {
+  auto* tree_model = gtk_tree_view_get_model(GetTreeView(table));
+  if (!tree_model)
+    return;
+  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+  GtkTreePath* tree_path = GetTreePath(tree_model, row);
+  gtk_tree_model_row_changed(tree_model, tree_path, &iter);
+  gtk_tree_path_free(tree_path);
+}
+
+// Expand the rows of the tree view for the expanded children of |row|, -1
+// means the top level rows. Deeper rows are expanded by OnRowExpanded.
+void ExpandTreeRows(Table* table, int row) {
+  GtkTreeView* tree_view = GetTreeView(table);
+  TreeTableModel* tree = GetTreeTableModel(table);
+  auto* tree_model = gtk_tree_view_get_model(tree_view);
+  if (!tree || !tree_model)
+    return;
+  for (int child = tree->GetChildRow(row, 0); child >= 0;
+       child = tree->GetNextSiblingRow(child)) {
+    if (!tree->IsExpanded(child) || tree->GetChildCount(child) == 0)
+      continue;
+    GtkTreePath* tree_path = GetTreePath(tree_model, child);
+    gtk_tree_view_expand_row(tree_view, tree_path, false);
+    gtk_tree_path_free(tree_path);
+  }
+}
+
+// Expand |row| in the tree view after its children are inserted.
+void ExpandTreeRow(Table* table, uint32_t row) {
+  GtkTreeView* tree_view = GetTreeView(table);
+  auto* tree_model = gtk_tree_view_get_model(tree_view);
+  // The tree view inserts the rows itself when it is expanding the row.
+  if (GPOINTER_TO_INT(g_object_get_data(G_OBJECT(tree_view),
+                                        "expanding-row")) ==
+          static_cast<int>(row + 1))
+    return;
+  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+  GtkTreePath* tree_path = GetTreePath(tree_model, row);
+  gtk_tree_model_row_has_child_toggled(tree_model, tree_path, &iter);
+  gtk_tree_view_expand_row(tree_view, tree_path, false);
+  gtk_tree_path_free(tree_path);
+}
+
+// Remove the children of |row| from the tree view after they are removed from
+// model. Deleting a row also removes its descendants from the tree view, and
+// the row is no longer expanded after its last child is deleted.
+void RemoveTreeChildren(Table* table, uint32_t row) {
+  GtkTreeView* tree_view = GetTreeView(table);
+  auto* tree_model = gtk_tree_view_get_model(tree_view);
+  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
+  GtkTreePath* tree_path = GetTreePath(tree_model, row);
+  GtkTreePath* child_path = gtk_tree_path_copy(tree_path);
+  gtk_tree_path_append_index(child_path, 0);
+  while (gtk_tree_view_row_expanded(tree_view, tree_path))
+    gtk_tree_model_row_deleted(tree_model, child_path);
+  gtk_tree_model_row_has_child_toggled(tree_model, tree_path, &iter);
+  gtk_tree_path_free(child_path);
+  gtk_tree_path_free(tree_path);
+}
+
+// Show the expanders in the tree column of model.
+void UpdateExpanderColumn(Table* table) {
+  GtkTreeView* tree_view = GetTreeView(table);
+  TreeTableModel* tree = GetTreeTableModel(table);
+  gtk_tree_view_set_show_expanders(tree_view,
+                                   tree && tree->GetTreeColumn() >= 0);
+  if (!tree)
+    return;
+  GtkTreeViewColumn* expander_column = nullptr;
+  for (int i = 0; i < table->GetColumnCount(); ++i) {
+    GtkTreeViewColumn* column = gtk_tree_view_get_column(tree_view, i);
+    if (GPOINTER_TO_INT(g_object_get_data(G_OBJECT(column), "column")) ==
+            tree->GetTreeColumn()) {
+      expander_column = column;
+      break;
+    }
+  }
+  gtk_tree_view_set_expander_column(tree_view, expander_column);
+}
+
+// Replace the tree model while keeping the scroll position and selection,
+// the selected rows are mapped with |map_row|, which returns -1 for rows that
+// no longer exist.
+void SwapTreeModel(Table* table, const std::function<int(int)>& map_row) {
+  GtkTreeView* tree_view = GetTreeView(table);
+  if (!gtk_tree_view_get_model(tree_view))
+    return;
+  std::set<int> selection;
+  for (int row : table->GetSelectedRows()) {
+    int new_row = map_row(row);
+    if (new_row >= 0)
+      selection.insert(new_row);
+  }
+  GtkAdjustment* vadjustment =
+      gtk_scrollable_get_vadjustment(GTK_SCROLLABLE(tree_view));
+  double scroll = gtk_adjustment_get_value(vadjustment);
+  NUTreeModel* tree_model = nu_tree_model_new(table, table->GetModel());
+  gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  g_object_unref(tree_model);
+  ExpandTreeRows(table, -1);
+  table->SelectRows(std::move(selection));
+  gtk_adjustment_set_value(vadjustment, scroll);
+}
+
 // Calculate the default row height of cell.
 int GetDefaultRowHeight() {
   // Cache calls.
@@ -43,6 +222,41 @@ void OnTableRowActivated(GtkTreeView*, GtkTreePath*, GtkTreeViewColumn*,
   table->on_row_activate.Emit(table, table->GetSelectedRow());
 }
 
+// Called before the tree view expands a row, load the children of the node.
+gboolean OnTestExpandRow(GtkTreeView* tree_view, GtkTreeIter* iter,
+                         GtkTreePath* path, Table* table) {
+  TreeTableModel* tree = GetTreeTableModel(table);
+  if (!tree)
+    return true;
+  int row = GPOINTER_TO_INT(iter->user_data);
+  // Rows are inserted by the tree view itself after this handler returns.
+  g_object_set_data(G_OBJECT(tree_view), "expanding-row",
+                    GINT_TO_POINTER(row + 1));
+  tree->Expand(row);
+  g_object_set_data(G_OBJECT(tree_view), "expanding-row", nullptr);
+  // Cancel expanding when the node turns out to have no child.
+  if (tree->GetChildCount(row) == 0) {
+    gtk_tree_model_row_has_child_toggled(gtk_tree_view_get_model(tree_view),
+                                         path, iter);
+    return true;
+  }
+  return false;
+}
+
+// Called after the tree view expanded a row, restore expanded children.
+void OnRowExpanded(GtkTreeView* tree_view, GtkTreeIter* iter,
+                   GtkTreePath* path, Table* table) {
+  ExpandTreeRows(table, GPOINTER_TO_INT(iter->user_data));
+}
+
+// Called after the tree view collapsed a row, drop the rows of descendants.
+void OnRowCollapsed(GtkTreeView* tree_view, GtkTreeIter* iter,
+                    GtkTreePath* path, Table* table) {
+  TreeTableModel* tree = GetTreeTableModel(table);
+  if (tree)
+    tree->Collapse(GPOINTER_TO_INT(iter->user_data));
+}
+
 // Called when selection of row has changed.
 void OnTableSelectionChanged(GtkTreeSelection*, Table* table) {
   table->on_selection_change.Emit(table);
@@ -57,13 +271,29 @@ void OnEdited(GtkCellRendererText* cell,
   auto* tree_path = gtk_tree_path_new_from_string(path);
   if (!tree_path)
     return;
-  gint row = gtk_tree_path_get_indices(tree_path)[0];
+  int row = GetRowFromTreePath(
+      gtk_tree_view_get_model(GetTreeView(table)), tree_path);
   gtk_tree_path_free(tree_path);
+  if (row < 0)
+    return;
   // Set value.
   gint column = GPOINTER_TO_INT(g_object_get_data(G_OBJECT(cell), "column"));
   table->GetModel()->SetValue(column, row, base::Value(new_text));
 }
 
+// Called by interactive search for each row, returns false when |iter|
+// matches |key|. Matches are looked up in the search index instead of reading
+// the value of every row.
+gboolean OnSearchEqual(GtkTreeModel*, gint, const gchar* key,
+                       GtkTreeIter* iter, gpointer data) {
+  auto* index = static_cast<TableSearchIndex*>(data);
+  if (!index)
+    return true;
+  const std::vector<int>& rows = index->FindRows(key);
+  return !std::binary_search(rows.begin(), rows.end(),
+                             GPOINTER_TO_INT(iter->user_data));
+}
+
 // Called to provide data to cell renderer.
 void TreeCellData(GtkTreeViewColumn* tree_column,
                   GtkCellRenderer* renderer,
@@ -72,26 +302,42 @@ void TreeCellData(GtkTreeViewColumn* tree_column,
                   void* user_data) {
   auto* options = static_cast<Table::ColumnOptions*>(user_data);
 
-  // Read value from model.
-  GValue gval = G_VALUE_INIT;
-  gtk_tree_model_get_value(tree_model, iter, options->column, &gval);
-  auto* value = static_cast<base::Value*>(g_value_get_boxed(&gval));
+  // Cached cells read value from model only when they have to be redrawn.
+  if (options->type == Table::ColumnType::Custom &&
+      nu_custom_cell_renderer_has_raster_cache(
+          NU_CUSTOM_CELL_RENDERER(renderer))) {
+    nu_custom_cell_renderer_set_row(NU_CUSTOM_CELL_RENDERER(renderer),
+                                    tree_model,
+                                    GPOINTER_TO_INT(iter->user_data));
+    return;
+  }
+
+  // Read value from model, without copying when possible.
+  base::Value buffer;
+  const base::Value* value = nu_tree_model_peek_value(
+      NU_TREE_MODEL(tree_model), iter, options->column, &buffer);
 
   // Pass value.
   switch (options->type) {
     case Table::ColumnType::Text:
     case Table::ColumnType::Edit: {
-      if (value && value->is_string())
+      if (value->is_string())
         g_object_set(renderer, "text", value->GetString().c_str(), nullptr);
       break;
     }
 
     case nu::Table::ColumnType::Custom: {
-      g_object_set(renderer, "value", value, nullptr);
+      // The "value" property takes a pointer, the renderer moves the content
+      // of buffer into its own storage. A borrowed value is kept alive by the
+      // model until rendering.
+      if (value == &buffer)
+        g_object_set(renderer, "value", &buffer, nullptr);
+      else
+        nu_custom_cell_renderer_set_value_ref(
+            NU_CUSTOM_CELL_RENDERER(renderer), value);
       break;
     }
   }
-  g_value_unset(&gval);
 }
 
 }  // namespace
@@ -101,6 +347,11 @@ NativeView Table::PlatformCreate() {
   gtk_tree_view_set_fixed_height_mode(GTK_TREE_VIEW(tree_view), true);
   g_signal_connect(tree_view, "row-activated", G_CALLBACK(OnTableRowActivated),
                    this);
+  g_signal_connect(tree_view, "test-expand-row", G_CALLBACK(OnTestExpandRow),
+                   this);
+  g_signal_connect(tree_view, "row-expanded", G_CALLBACK(OnRowExpanded), this);
+  g_signal_connect(tree_view, "row-collapsed", G_CALLBACK(OnRowCollapsed),
+                   this);
   gtk_widget_show(tree_view);
 
   GtkTreeSelection* selection =
@@ -119,6 +370,7 @@ NativeView Table::PlatformCreate() {
 void Table::PlatformDestroy() {
   // The widget relies on Table to get items, so we must ensure the
   // widget is destroyed before this class.
+  cached_renderers_.clear();
   View::PlatformDestroy();
 }
 
@@ -127,6 +379,18 @@ void Table::PlatformSetModel(TableModel* model) {
                                                     "widget"));
   NUTreeModel* tree_model = nu_tree_model_new(this, model);
   gtk_tree_view_set_model(tree_view, GTK_TREE_MODEL(tree_model));
+  g_object_unref(tree_model);
+  InvalidateRasterCache(cached_renderers_, -1, 0);
+  UpdateExpanderColumn(this);
+  ExpandTreeRows(this, -1);
+}
+
+void Table::PlatformSetSearchColumn(int column) {
+  GtkTreeView* tree_view = GetTreeView(this);
+  gtk_tree_view_set_enable_search(tree_view, column >= 0);
+  gtk_tree_view_set_search_column(tree_view, column);
+  gtk_tree_view_set_search_equal_func(tree_view, OnSearchEqual,
+                                      search_index_.get(), nullptr);
 }
 
 void Table::AddColumnWithOptions(const std::string& title,
@@ -146,6 +410,8 @@ void Table::AddColumnWithOptions(const std::string& title,
       break;
     case Table::ColumnType::Custom:
       renderer = nu_custom_cell_renderer_new(options);
+      if (options.raster_cache_size > 0)
+        cached_renderers_.push_back(renderer);
       break;
   }
   // Store the column index for later use.
@@ -162,7 +428,9 @@ void Table::AddColumnWithOptions(const std::string& title,
   gtk_tree_view_column_set_resizable(tree_column, true);
   if (options.width != -1)
     gtk_tree_view_column_set_fixed_width(tree_column, options.width);
+  g_object_set_data(G_OBJECT(tree_column), "column", GINT_TO_POINTER(column));
   gtk_tree_view_append_column(tree_view, tree_column);
+  UpdateExpanderColumn(this);
 
   // Pass the ColumnOptions to renderer.
   auto* data = new ColumnOptions(options);
@@ -261,53 +529,88 @@ std::set<int> Table::GetSelectedRows() const {
       GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()), "widget")));
   GList* list = gtk_tree_selection_get_selected_rows(selection, nullptr);
   std::set<int> rows;
+  GtkTreeModel* tree_model = gtk_tree_view_get_model(
+      GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()), "widget")));
   for (GList* node = list; node != nullptr; node = node->next) {
-    auto* path = static_cast<GtkTreePath*>(node->data);
-    gint* indices = gtk_tree_path_get_indices(path);
-    if (!indices) {
+    int row = GetRowFromTreePath(tree_model,
+                                 static_cast<GtkTreePath*>(node->data));
+    if (row < 0) {
       NOTREACHED();
       continue;
     }
-    rows.insert(indices[0]);
+    rows.insert(row);
   }
   g_list_foreach(list, (GFunc)gtk_tree_path_free, nullptr);
   g_list_free(list);
   return rows;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
-  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
-                                                    "widget"));
-  auto* tree_model = gtk_tree_view_get_model(tree_view);
-  if (!tree_model)
+void Table::OnRowsInserted(uint32_t start, uint32_t count) {
+  InvalidateRasterCache(cached_renderers_, -1, start);
+  if (GetTreeTableModel(this)) {
+    // Rows of a tree are always inserted as the descendants of the row
+    // before them, show them by expanding it.
+    ExpandTreeRow(this, start - 1);
     return;
-  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_inserted(tree_model, tree_path, &iter);
-  gtk_tree_path_free(tree_path);
+  }
+  if (count > kMaxRowSignals) {
+    SwapTreeModel(this, [start, count](int row) {
+      if (static_cast<uint32_t>(row) < start)
+        return row;
+      return static_cast<int>(row + count);
+    });
+    return;
+  }
+  for (uint32_t i = 0; i < count; ++i)
+    EmitRowInserted(this, start + i);
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
-  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
-                                                    "widget"));
-  auto* tree_model = gtk_tree_view_get_model(tree_view);
-  if (!tree_model)
+void Table::OnRowsDeleted(uint32_t start, uint32_t count) {
+  InvalidateRasterCache(cached_renderers_, -1, start);
+  if (count > kMaxRowSignals) {
+    SwapTreeModel(this, [start, count](int row) {
+      if (static_cast<uint32_t>(row) < start)
+        return row;
+      if (static_cast<uint32_t>(row) < start + count)
+        return -1;
+      return static_cast<int>(row - count);
+    });
     return;
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_deleted(tree_model, tree_path);
-  gtk_tree_path_free(tree_path);
+  }
+  if (GetTreeTableModel(this)) {
+    // Rows of a tree are always deleted as all the descendants of the row
+    // before them.
+    RemoveTreeChildren(this, start - 1);
+    return;
+  }
+  // Each deletion shifts the following rows up.
+  for (uint32_t i = 0; i < count; ++i)
+    EmitRowDeleted(this, start);
 }
 
-void Table::NotifyValueChange(uint32_t column, uint32_t row) {
-  auto* tree_view = GTK_TREE_VIEW(g_object_get_data(G_OBJECT(GetNative()),
-                                                    "widget"));
-  auto* tree_model = gtk_tree_view_get_model(tree_view);
-  if (!tree_model)
+void Table::OnRangeChanged(uint32_t start, uint32_t count) {
+  InvalidateRasterCache(cached_renderers_, -1, start, start + count);
+  // With fixed height mode, changed rows only need to be redrawn.
+  if (count > kMaxRowSignals) {
+    gtk_widget_queue_draw(GTK_WIDGET(GetTreeView(this)));
     return;
-  GtkTreeIter iter = {true, GINT_TO_POINTER(row)};
-  GtkTreePath* tree_path = gtk_tree_path_new_from_indices(row, -1);
-  gtk_tree_model_row_changed(tree_model, tree_path, &iter);
-  gtk_tree_path_free(tree_path);
+  }
+  for (uint32_t row = start; row < start + count; ++row)
+    EmitRowChanged(this, row);
+}
+
+void Table::OnValueChanged(uint32_t column, uint32_t row) {
+  InvalidateRasterCache(cached_renderers_, column, row, row + 1);
+  EmitRowChanged(this, row);
+}
+
+void Table::OnReset() {
+  InvalidateRasterCache(cached_renderers_, -1, 0);
+  uint32_t count = GetModel() ? GetModel()->GetRowCount() : 0;
+  SwapTreeModel(this, [count](int row) {
+    return static_cast<uint32_t>(row) < count ? row : -1;
+  });
+  UpdateExpanderColumn(this);
 }
 
 }  // namespace nu
@@ -289,6 +289,11 @@ void View::SetPixelBounds(const Rect& bounds) {
   gtk_widget_get_preferred_width(view_, &tmp, nullptr);
   gtk_widget_get_preferred_height(view_, &tmp, nullptr);
 
+  GdkRectangle old;
+  gtk_widget_get_allocation(view_, &old);
+  if (!gdk_rectangle_equal(&old, &rect))
+    InvalidateRasterCache();
+
   gtk_widget_size_allocate(view_, &rect);
 }
 
@@ -314,15 +319,25 @@ Rect View::GetPixelBounds() const {
 }
 
 void View::SchedulePaint() {
+  InvalidateRasterCache();
   gtk_widget_queue_draw(view_);
 }
 
 void View::SchedulePaintRect(const RectF& rect) {
+  InvalidateRasterCache();
   gtk_widget_queue_draw_area(view_,
                              rect.x(), rect.y(), rect.width(), rect.height());
 }
 
+void View::InvalidateRasterCache() {
+  for (View* view = this; view; view = view->GetParent()) {
+    if (view->IsContainer())
+      static_cast<Container*>(view)->DropRasterCache();
+  }
+}
+
 void View::PlatformSetVisible(bool visible) {
+  InvalidateRasterCache();
   gtk_widget_set_visible(view_, visible);
 }
 
@@ -491,16 +506,19 @@ void View::PlatformRemoveTooltip(int id) {
 }
 
 void View::PlatformSetFont(Font* font) {
+  InvalidateRasterCache();
   gtk_widget_override_font(view_, font->GetNative());
 }
 
 void View::SetColor(Color color) {
+  InvalidateRasterCache();
   ApplyStyle(view_, "color",
              base::StringPrintf("* { color: %s; }",
                                 color.ToString().c_str()));
 }
 
 void View::SetBackgroundColor(Color color) {
+  InvalidateRasterCache();
   ApplyStyle(view_, "background-color",
              base::StringPrintf("* { background-color: %s; }",
                                 color.ToString().c_str()));
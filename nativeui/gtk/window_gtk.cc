@@ -8,6 +8,7 @@
 
 #include "nativeui/gtk/util/widget_util.h"
 #include "nativeui/menu_bar.h"
+#include "nativeui/message_loop.h"
 #include "nativeui/screen.h"
 
 namespace nu {
@@ -40,6 +41,9 @@ struct NUWindowPrivate {
   bool is_input_shape_set = false;
   bool is_draw_handler_set = false;
   guint draw_handler_id = 0;
+  // Frame clock used for deferred layout.
+  GdkFrameClock* frame_clock = nullptr;
+  gulong layout_handler_id = 0;
 };
 
 // Helper to receive private data.
@@ -135,6 +139,20 @@ gboolean OnDrawBackground(GtkWidget* widget, cairo_t* cr,
   return FALSE;
 }
 
+// The frame clock is in the layout phase.
+void OnFrameClockLayout(GdkFrameClock* clock, Window* window) {
+  window->FlushLayout();
+}
+
+// Stop receiving layout phases from the frame clock.
+void DisconnectFrameClock(NUWindowPrivate* priv) {
+  if (!priv->frame_clock)
+    return;
+  g_signal_handler_disconnect(priv->frame_clock, priv->layout_handler_id);
+  g_object_unref(priv->frame_clock);
+  priv->frame_clock = nullptr;
+}
+
 // Get the height of menubar.
 inline int GetMenuBarHeight(const Window* window) {
   MenuBar* menu_bar = window->GetMenuBar();
@@ -208,6 +226,7 @@ void Window::PlatformInit(const Options& options) {
 void Window::PlatformDestroy() {
   if (!window_)
     return;
+  DisconnectFrameClock(GetPrivate(this));
   GetPrivate(this)->shell = nullptr;
   gtk_widget_destroy(GTK_WIDGET(window_));
   window_ = nullptr;
@@ -252,6 +271,27 @@ void Window::PlatformSetContentView(View* view) {
   }
 }
 
+void Window::PlatformScheduleLayout() {
+  if (!window_)
+    return;
+  GdkFrameClock* clock = gtk_widget_get_frame_clock(GTK_WIDGET(window_));
+  if (!clock) {
+    // The window is not realized yet, there is no paint to wait for.
+    scoped_refptr<Window> self(this);
+    MessageLoop::PostTask([self]() { self->FlushLayout(); });
+    return;
+  }
+  // The clock changes when the window is re-realized.
+  NUWindowPrivate* priv = GetPrivate(this);
+  if (priv->frame_clock != clock) {
+    DisconnectFrameClock(priv);
+    priv->frame_clock = GDK_FRAME_CLOCK(g_object_ref(clock));
+    priv->layout_handler_id = g_signal_connect(
+        clock, "layout", G_CALLBACK(OnFrameClockLayout), this);
+  }
+  gdk_frame_clock_request_phase(clock, GDK_FRAME_CLOCK_PHASE_LAYOUT);
+}
+
 void Window::Center() {
   Display display = Screen::GetCurrent()->GetDisplayNearestWindow(this);
   if (display.work_area.IsEmpty())
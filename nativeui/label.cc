@@ -19,9 +19,17 @@ YGSize MeasureLabel(YGNodeRef node,
                     float width, YGMeasureMode mode,
                     float height, YGMeasureMode height_mode) {
   auto* label = static_cast<Label*>(YGNodeGetContext(node));
-  SizeF size = label->GetAttributedText()
-                    ->GetBoundsFor(SizeF(width, height)).size();
-  size.Enlarge(1, 1);  // leave space for border
+  AttributedText* text = label->GetAttributedText();
+  // Yoga may ask for the same size multiple times in one pass.
+  MeasureCache::Key key = {width, static_cast<int>(mode),
+                           height, static_cast<int>(height_mode),
+                           text->revision()};
+  SizeF size;
+  if (!label->measure_cache()->Get(key, &size)) {
+    size = text->GetBoundsFor(SizeF(width, height)).size();
+    size.Enlarge(1, 1);  // leave space for border
+    label->measure_cache()->Put(key, size);
+  }
   return {std::ceil(size.width()), std::ceil(size.height())};
 }
 
@@ -92,6 +100,7 @@ void Label::Init() {
 }
 
 void Label::MarkDirty() {
+  measure_cache_.Clear();
   YGNodeMarkDirty(node());
   SchedulePaint();
 }
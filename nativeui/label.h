@@ -8,6 +8,7 @@
 #include <string>
 
 #include "nativeui/gfx/text.h"
+#include "nativeui/util/measure_cache.h"
 #include "nativeui/view.h"
 
 namespace nu {
@@ -33,6 +34,9 @@ class NATIVEUI_EXPORT Label : public View {
   // Internal: Make sure the label is using system text color.
   void UpdateColor();
 
+  // Internal: Cached results of measuring the text.
+  MeasureCache* measure_cache() { return &measure_cache_; }
+
   // View:
   const char* GetClassName() const override;
   void SetFont(scoped_refptr<Font> font) override;
@@ -50,6 +54,7 @@ class NATIVEUI_EXPORT Label : public View {
   NativeView PlatformCreate();
 
   scoped_refptr<AttributedText> text_;
+  MeasureCache measure_cache_;
 
   bool use_system_color_;
   Color system_color_;
@@ -32,3 +32,23 @@ TEST_F(LabelTest, UpdateStyle) {
   EXPECT_EQ(height.value, YGNodeStyleGetMinHeight(label_->node()).value);
 }
 #endif
+
+TEST_F(LabelTest, MeasureCache) {
+  scoped_refptr<nu::Container> container(new nu::Container);
+  container->AddChildView(label_);
+  label_->SetText("test");
+  container->GetPreferredSize();
+  int misses = label_->measure_cache()->misses();
+  int hits = label_->measure_cache()->hits();
+  EXPECT_GT(misses, 0);
+  // Changing margin makes yoga measure again with the same constraints.
+  label_->SetStyleProperty("margin", 5);
+  container->GetPreferredSize();
+  EXPECT_EQ(label_->measure_cache()->misses(), misses);
+  EXPECT_GT(label_->measure_cache()->hits(), hits);
+  // Changing the text invalidates the cache.
+  label_->GetAttributedText()->SetText("longlongtest");
+  label_->SetStyleProperty("margin", 6);
+  container->GetPreferredSize();
+  EXPECT_GT(label_->measure_cache()->misses(), misses);
+}
@@ -5,6 +5,7 @@
 #include "nativeui/state.h"
 
 #include "nativeui/mac/events_handler.h"
+#include "nativeui/util/yoga_util.h"
 #include "third_party/yoga/Yoga.h"
 
 namespace nu {
@@ -22,7 +23,7 @@ void State::PlatformInit() {
     [[NSUserDefaults standardUserDefaults] registerDefaults:defaults];
   }
 
-  YGConfigSetPointScaleFactor(yoga_config(),
+  YGConfigSetPointScaleFactor(yoga_config()->get(),
                               [NSScreen mainScreen].backingScaleFactor);
 }
 
@@ -4,7 +4,11 @@
 
 #include "nativeui/table.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "base/mac/scoped_nsobject.h"
+#include "base/strings/sys_string_conversions.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/mac/nu_private.h"
 #include "nativeui/mac/nu_view.h"
@@ -44,6 +48,23 @@
   return tableCell;
 }
 
+- (NSInteger)tableView:(NSTableView*)tableView
+    nextTypeSelectMatchFromRow:(NSInteger)startRow
+                         toRow:(NSInteger)endRow
+                     forString:(NSString*)searchString {
+  if (shell_->GetSearchColumn() < 0)
+    return -1;
+  // The range from |startRow| to |endRow| may wrap around the end.
+  std::vector<int> rows =
+      shell_->FindRows(base::SysNSStringToUTF8(searchString));
+  auto it = std::lower_bound(rows.begin(), rows.end(), startRow);
+  if (it != rows.end() && (endRow < startRow || *it < endRow))
+    return *it;
+  if (endRow < startRow && !rows.empty() && rows.front() < endRow)
+    return rows.front();
+  return -1;
+}
+
 - (void)tableViewSelectionDidChange:(NSNotification*)notification {
   shell_->on_selection_change.Emit(shell_);
 }
@@ -145,6 +166,12 @@ void Table::PlatformSetModel(TableModel* model) {
   [table setModel:model];
 }
 
+void Table::PlatformSetSearchColumn(int column) {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  [tableView setAllowsTypeSelect:column >= 0];
+}
+
 void Table::AddColumnWithOptions(const std::string& title,
                                  const ColumnOptions& options) {
   auto* tableView = static_cast<NSTableView*>(
@@ -244,25 +271,46 @@ std::set<int> Table::GetSelectedRows() const {
   return selection;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+void Table::OnRowsInserted(uint32_t start, uint32_t count) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
-  [tableView insertRowsAtIndexes:[NSIndexSet indexSetWithIndex:row]
+  [tableView insertRowsAtIndexes:[NSIndexSet
+                                     indexSetWithIndexesInRange:NSMakeRange(
+                                         start, count)]
                    withAnimation:NSTableViewAnimationEffectNone];
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::OnRowsDeleted(uint32_t start, uint32_t count) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
-  [tableView removeRowsAtIndexes:[NSIndexSet indexSetWithIndex:row]
+  [tableView removeRowsAtIndexes:[NSIndexSet
+                                     indexSetWithIndexesInRange:NSMakeRange(
+                                         start, count)]
                    withAnimation:NSTableViewAnimationEffectNone];
 }
 
-void Table::NotifyValueChange(uint32_t column, uint32_t row) {
+void Table::OnRangeChanged(uint32_t start, uint32_t count) {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  NSRange columns = NSMakeRange(0, [tableView numberOfColumns]);
+  [tableView reloadDataForRowIndexes:[NSIndexSet
+                                         indexSetWithIndexesInRange:NSMakeRange(
+                                             start, count)]
+                       columnIndexes:[NSIndexSet
+                                         indexSetWithIndexesInRange:columns]];
+}
+
+void Table::OnValueChanged(uint32_t column, uint32_t row) {
   auto* tableView = static_cast<NSTableView*>(
       [static_cast<NUTable*>(GetNative()) documentView]);
   [tableView reloadDataForRowIndexes:[NSIndexSet indexSetWithIndex:row]
                        columnIndexes:[NSIndexSet indexSetWithIndex:column]];
 }
 
+void Table::OnReset() {
+  auto* tableView = static_cast<NSTableView*>(
+      [static_cast<NUTable*>(GetNative()) documentView]);
+  [tableView reloadData];
+}
+
 }  // namespace nu
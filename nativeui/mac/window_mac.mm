@@ -13,6 +13,7 @@
 #include "nativeui/mac/nu_responder.h"
 #include "nativeui/mac/nu_view.h"
 #include "nativeui/mac/nu_window.h"
+#include "nativeui/util/yoga_util.h"
 #include "third_party/yoga/Yoga.h"
 
 #if defined(OS_MAC)
@@ -100,7 +101,7 @@ void Window::PlatformInit(const Options& options) {
   // Disable tab menu items.
   [window_ setTabbingMode:NSWindowTabbingModeDisallowed];
 
-  YGConfigSetPointScaleFactor(yoga_config_,
+  YGConfigSetPointScaleFactor(yoga_config_->get(),
                               [window_ screen].backingScaleFactor);
 
   if (!HasFrame()) {
@@ -0,0 +1,19 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/message_loop.h"
+
+#include <utility>
+
+#include "nativeui/thread_pool.h"
+
+namespace nu {
+
+// static
+void MessageLoop::PostBackgroundTask(Task task, Task reply) {
+  ThreadPool::GetDefault()->PostTaskAndReply(std::move(task),
+                                             std::move(reply));
+}
+
+}  // namespace nu
@@ -29,6 +29,10 @@ class NATIVEUI_EXPORT MessageLoop {
   static void PostTask(Task task);
   static void PostDelayedTask(int ms, Task task);
 
+  // Run |task| in the default ThreadPool, and then run |reply| on the main
+  // thread.
+  static void PostBackgroundTask(Task task, Task reply = nullptr);
+
   // Internal: Cancellable timers.
 #if defined(OS_WIN)
   using TimerId = UINT_PTR;
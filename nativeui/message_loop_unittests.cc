@@ -2,7 +2,12 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <memory>
+#include <thread>
+#include <vector>
+
 #include "nativeui/nativeui.h"
+#include "nativeui/util/timer_wheel.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
 class MessageLoopTest : public testing::Test {
@@ -20,3 +25,124 @@ TEST_F(MessageLoopTest, PostTask) {
   });
   nu::MessageLoop::Run();
 }
+
+TEST_F(MessageLoopTest, PostTaskOrder) {
+  std::vector<int> order;
+  for (int i = 0; i < 100; ++i)
+    nu::MessageLoop::PostTask([&order, i]() { order.push_back(i); });
+  nu::MessageLoop::PostTask([]() {
+    nu::MessageLoop::Quit();
+  });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(order.size(), 100u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_EQ(order[i], i);
+}
+
+TEST_F(MessageLoopTest, PostTaskFromThreads) {
+  constexpr int kThreads = 8;
+  constexpr int kTasksPerThread = 50000;
+  int count = 0;
+  std::vector<int> last(kThreads, -1);
+  bool in_order = true;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back([&, t]() {
+      for (int i = 0; i < kTasksPerThread; ++i) {
+        nu::MessageLoop::PostTask([&, t, i]() {
+          // Tasks from the same thread run in the order they are posted.
+          if (last[t] != i - 1)
+            in_order = false;
+          last[t] = i;
+          if (++count == kThreads * kTasksPerThread)
+            nu::MessageLoop::Quit();
+        });
+      }
+    });
+  }
+  nu::MessageLoop::Run();
+  for (std::thread& thread : threads)
+    thread.join();
+  EXPECT_EQ(count, kThreads * kTasksPerThread);
+  EXPECT_TRUE(in_order);
+}
+
+TEST_F(MessageLoopTest, TimerWheel) {
+  nu::TimerWheel wheel(1000);
+  std::vector<int> fired;
+  auto run_expired = [&]() {
+    nu::TimerWheel::Task task;
+    while (wheel.PopExpired(&task))
+      task();
+  };
+  wheel.Add(1005, [&]() { fired.push_back(5); });
+  wheel.Add(1100, [&]() { fired.push_back(100); });
+  nu::TimerWheel::TimerId id = wheel.Add(1500, [&]() { fired.push_back(500); });
+  wheel.Add(1000 + 10 * 60 * 1000, [&]() { fired.push_back(600000); });
+  EXPECT_EQ(wheel.size(), 4u);
+  uint64_t tick;
+  ASSERT_TRUE(wheel.GetNextTick(&tick));
+  EXPECT_EQ(tick, 1005u);
+  wheel.Advance(1004);
+  run_expired();
+  EXPECT_TRUE(fired.empty());
+  wheel.Advance(1005);
+  run_expired();
+  EXPECT_EQ(fired, std::vector<int>({5}));
+  nu::TimerWheel::Task cancelled;
+  EXPECT_TRUE(wheel.Cancel(id, &cancelled));
+  EXPECT_TRUE(cancelled);
+  EXPECT_FALSE(wheel.Cancel(id));
+  wheel.Advance(2000);
+  run_expired();
+  EXPECT_EQ(fired, std::vector<int>({5, 100}));
+  // Timers in higher levels are moved down before they expire.
+  while (wheel.GetNextTick(&tick)) {
+    ASSERT_LE(tick, 1000u + 10 * 60 * 1000);
+    wheel.Advance(tick);
+    run_expired();
+  }
+  EXPECT_EQ(fired, std::vector<int>({5, 100, 600000}));
+  EXPECT_EQ(wheel.size(), 0u);
+}
+
+TEST_F(MessageLoopTest, ManyTimeouts) {
+  constexpr int kTimers = 10000;
+  int count = 0;
+  std::vector<nu::MessageLoop::TimerId> cancelled;
+  for (int i = 0; i < kTimers; ++i) {
+    nu::MessageLoop::TimerId id = nu::MessageLoop::SetTimeout(i % 50, [&]() {
+      if (++count == kTimers / 2)
+        nu::MessageLoop::PostDelayedTask(60, []() {
+          nu::MessageLoop::Quit();
+        });
+    });
+    if (i % 2)
+      cancelled.push_back(id);
+  }
+  for (nu::MessageLoop::TimerId id : cancelled)
+    nu::MessageLoop::ClearTimeout(id);
+  nu::MessageLoop::Run();
+  EXPECT_EQ(count, kTimers / 2);
+}
+
+namespace {
+
+// Adds a timer when destroyed.
+struct QuitOnDestroy {
+  ~QuitOnDestroy() {
+    nu::MessageLoop::SetTimeout(0, []() { nu::MessageLoop::Quit(); });
+  }
+};
+
+}  // namespace
+
+TEST_F(MessageLoopTest, ClearTimeoutDestroysTaskWithoutLock) {
+  auto guard = std::make_shared<QuitOnDestroy>();
+  nu::MessageLoop::TimerId id = nu::MessageLoop::SetTimeout(
+      10000, [guard]() {});
+  guard.reset();
+  // Would deadlock if the task was destroyed with the lock held.
+  nu::MessageLoop::ClearTimeout(id);
+  nu::MessageLoop::Run();
+}
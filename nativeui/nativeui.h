@@ -7,6 +7,7 @@
 
 #include "nativeui/app.h"
 #include "nativeui/appearance.h"
+#include "nativeui/async_table_model.h"
 #include "nativeui/browser.h"
 #include "nativeui/button.h"
 #include "nativeui/combo_box.h"
@@ -24,6 +25,8 @@
 #include "nativeui/gfx/geometry/insets.h"
 #include "nativeui/gfx/image.h"
 #include "nativeui/gfx/painter.h"
+#include "nativeui/gfx/picture.h"
+#include "nativeui/gfx/picture_recorder.h"
 #include "nativeui/gif_player.h"
 #include "nativeui/group.h"
 #include "nativeui/label.h"
@@ -36,17 +39,21 @@
 #include "nativeui/notification.h"
 #include "nativeui/notification_center.h"
 #include "nativeui/progress_bar.h"
+#include "nativeui/projected_table_model.h"
 #include "nativeui/protocol_asar_job.h"
 #include "nativeui/screen.h"
 #include "nativeui/scroll.h"
 #include "nativeui/separator.h"
 #include "nativeui/slider.h"
 #include "nativeui/state.h"
+#include "nativeui/style.h"
 #include "nativeui/tab.h"
 #include "nativeui/table.h"
 #include "nativeui/table_model.h"
 #include "nativeui/text_edit.h"
+#include "nativeui/thread_pool.h"
 #include "nativeui/tray.h"
+#include "nativeui/tree_table_model.h"
 #include "nativeui/window.h"
 
 #if defined(OS_MAC)
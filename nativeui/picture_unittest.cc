@@ -0,0 +1,32 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class PictureTest : public testing::Test {
+ protected:
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(PictureTest, RecordAndReplay) {
+  scoped_refptr<nu::PictureRecorder> recorder = new nu::PictureRecorder;
+  nu::Painter* painter = recorder->GetPainter();
+  painter->SetFillColor(nu::Color(255, 0, 0));
+  painter->BeginPath();
+  painter->Arc(nu::PointF(50, 50), 20, 0, 3.14f);
+  painter->Fill();
+  painter->FillRect(nu::RectF(0, 0, 10, 10));
+  scoped_refptr<nu::Picture> picture = recorder->FinishRecording();
+  EXPECT_EQ(picture->GetCommandCount(), 5);
+  EXPECT_EQ(recorder->FinishRecording()->GetCommandCount(), 0);
+
+  // Replaying on another recorder produces the same commands.
+  recorder->GetPainter()->DrawPicture(picture.get());
+  EXPECT_EQ(recorder->FinishRecording()->GetCommandCount(), 5 + 2);
+
+  scoped_refptr<nu::Canvas> canvas = new nu::Canvas(nu::SizeF(100, 100));
+  canvas->GetPainter()->DrawPicture(picture.get());
+}
@@ -0,0 +1,386 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/projected_table_model.h"
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <memory>
+#include <utility>
+
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/thread_pool.h"
+
+namespace nu {
+
+namespace {
+
+// Marks a row that has been removed from source.
+constexpr uint32_t kInvalidRow = std::numeric_limits<uint32_t>::max();
+
+// Changes of more rows than this are handled by rebuilding the projection.
+constexpr uint32_t kMaxIncrementalRows = 64;
+
+// Each chunk sorted in parallel should have at least this number of rows.
+constexpr size_t kMinRowsPerThread = 50000;
+
+// Compare values of the same column, numbers are compared by their values
+// since base::Value stores them in different types.
+int CompareValues(const base::Value& a, const base::Value& b) {
+  bool a_is_number = a.is_int() || a.is_double();
+  bool b_is_number = b.is_int() || b.is_double();
+  if (a_is_number && b_is_number) {
+    double da = a.GetDouble();
+    double db = b.GetDouble();
+    return da < db ? -1 : (db < da ? 1 : 0);
+  }
+  if (a < b)
+    return -1;
+  if (b < a)
+    return 1;
+  return 0;
+}
+
+// Run |work| for each index in [0, count) on the default thread pool. The
+// calling thread takes part in the work, so it only waits for the indices that
+// are already running, and never for tasks stuck behind others in the pool.
+void ParallelFor(size_t count, const std::function<void(size_t)>& work) {
+  struct State {
+    State(size_t count, const std::function<void(size_t)>* work)
+        : count(count), work(work), done(&lock) {}
+
+    const size_t count;
+    const std::function<void(size_t)>* work;
+    std::atomic<size_t> next{0};
+    base::Lock lock;
+    base::ConditionVariable done;
+    size_t finished = 0;
+  };
+  if (count == 0)
+    return;
+  // Tasks that start after all work has finished only touch |next|, which is
+  // kept alive by the reference they hold.
+  auto state = std::make_shared<State>(count, &work);
+  auto run = [state]() {
+    size_t i;
+    while ((i = state->next.fetch_add(1)) < state->count) {
+      (*state->work)(i);
+      base::AutoLock auto_lock(state->lock);
+      if (++state->finished == state->count)
+        state->done.Signal();
+    }
+  };
+  ThreadPool* pool = ThreadPool::GetDefault();
+  size_t helpers = std::min(pool->GetThreadCount(), count - 1);
+  for (size_t i = 0; i < helpers; ++i)
+    pool->PostTask(run, ThreadPool::Priority::High);
+  run();
+  base::AutoLock auto_lock(state->lock);
+  while (state->finished < state->count)
+    state->done.Wait();
+}
+
+// Stable sort |rows|, splitting the work across the default thread pool for
+// large inputs.
+template<typename Compare>
+void ParallelStableSort(std::vector<uint32_t>* rows, const Compare& less) {
+  size_t size = rows->size();
+  size_t chunks = std::min(ThreadPool::GetDefault()->GetThreadCount() + 1,
+                           size / kMinRowsPerThread);
+  if (chunks < 2) {
+    std::stable_sort(rows->begin(), rows->end(), less);
+    return;
+  }
+  std::vector<size_t> bounds(chunks + 1);
+  for (size_t i = 0; i <= chunks; ++i)
+    bounds[i] = size * i / chunks;
+  auto begin = rows->begin();
+  ParallelFor(chunks, [&](size_t i) {
+    std::stable_sort(begin + bounds[i], begin + bounds[i + 1], less);
+  });
+  // Merge neighbouring chunks until there is only one left, merging earlier
+  // chunks first keeps the sort stable.
+  for (size_t step = 1; step < chunks; step *= 2) {
+    size_t merges = (chunks - step + step * 2 - 1) / (step * 2);
+    ParallelFor(merges, [&](size_t j) {
+      size_t i = j * step * 2;
+      std::inplace_merge(begin + bounds[i], begin + bounds[i + step],
+                         begin + bounds[std::min(i + step * 2, chunks)], less);
+    });
+  }
+}
+
+}  // namespace
+
+ProjectedTableModel::ProjectedTableModel(scoped_refptr<TableModel> source)
+    : source_(std::move(source)) {
+  source_->AddObserver(this);
+  rows_ = ComputeRows();
+}
+
+ProjectedTableModel::~ProjectedTableModel() {
+  source_->RemoveObserver(this);
+}
+
+void ProjectedTableModel::SetSortKeys(std::vector<SortKey> keys) {
+  sort_keys_ = std::move(keys);
+  Rebuild();
+}
+
+void ProjectedTableModel::SetFilter(Filter filter) {
+  filter_ = std::move(filter);
+  Rebuild();
+}
+
+void ProjectedTableModel::Refilter() {
+  Rebuild();
+}
+
+int ProjectedTableModel::GetSourceRow(uint32_t row) const {
+  if (row >= rows_.size())
+    return -1;
+  return static_cast<int>(rows_[row]);
+}
+
+int ProjectedTableModel::GetProjectedRow(uint32_t source_row) const {
+  if (!filter_ && sort_keys_.empty())
+    return source_row < rows_.size() ? static_cast<int>(source_row) : -1;
+  EnsureProjectedRows();
+  if (source_row >= projected_rows_.size())
+    return -1;
+  return projected_rows_[source_row];
+}
+
+uint32_t ProjectedTableModel::GetRowCount() const {
+  return static_cast<uint32_t>(rows_.size());
+}
+
+base::Value ProjectedTableModel::GetValue(uint32_t column,
+                                          uint32_t row) const {
+  if (row >= rows_.size())
+    return base::Value();
+  return source_->GetValue(column, rows_[row]);
+}
+
+const base::Value* ProjectedTableModel::GetValueRef(uint32_t column,
+                                                    uint32_t row) const {
+  if (row >= rows_.size())
+    return nullptr;
+  return source_->GetValueRef(column, rows_[row]);
+}
+
+void ProjectedTableModel::SetValue(uint32_t column, uint32_t row,
+                                   base::Value value) {
+  // The source will notify the change back.
+  if (row < rows_.size())
+    source_->SetValue(column, rows_[row], std::move(value));
+}
+
+void ProjectedTableModel::OnRowsInserted(uint32_t start,
+                                               uint32_t count) {
+  projected_rows_dirty_ = true;
+  for (uint32_t& row : rows_) {
+    if (row >= start)
+      row += count;
+  }
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  for (uint32_t row = start; row < start + count; ++row) {
+    if (IsRowVisible(row))
+      InsertSourceRow(row);
+  }
+}
+
+void ProjectedTableModel::OnRowsDeleted(uint32_t start,
+                                              uint32_t count) {
+  projected_rows_dirty_ = true;
+  // Update indices before notifying tables, so they never see stale rows.
+  for (uint32_t& row : rows_) {
+    if (row >= start + count)
+      row -= count;
+    else if (row >= start)
+      row = kInvalidRow;
+  }
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  // Remove from the back so the indices of remaining rows do not change.
+  for (size_t i = rows_.size(); i > 0; --i) {
+    if (rows_[i - 1] == kInvalidRow) {
+      rows_.erase(rows_.begin() + i - 1);
+      NotifyRowDeletion(static_cast<uint32_t>(i - 1));
+    }
+  }
+}
+
+void ProjectedTableModel::OnRangeChanged(uint32_t start,
+                                              uint32_t count) {
+  if (!filter_ && sort_keys_.empty()) {
+    NotifyRangeChanged(start, count);
+    return;
+  }
+  if (count > kMaxIncrementalRows) {
+    Rebuild();
+    return;
+  }
+  for (uint32_t row = start; row < start + count; ++row)
+    UpdateSourceRow(row);
+}
+
+void ProjectedTableModel::OnValueChanged(uint32_t column, uint32_t row) {
+  bool is_sort_key = std::any_of(sort_keys_.begin(), sort_keys_.end(),
+                                 [column](const SortKey& key) {
+                                   return key.column == column;
+                                 });
+  if (filter_ || is_sort_key) {
+    UpdateSourceRow(row);
+    return;
+  }
+  // The position of row does not change.
+  int projected_row = GetProjectedRow(row);
+  if (projected_row >= 0)
+    NotifyValueChange(column, projected_row);
+}
+
+void ProjectedTableModel::OnReset() {
+  rows_ = ComputeRows();
+  projected_rows_dirty_ = true;
+  NotifyReset();
+}
+
+std::vector<uint32_t> ProjectedTableModel::ComputeRows() const {
+  uint32_t count = source_->GetRowCount();
+  std::vector<uint32_t> rows;
+  rows.reserve(count);
+  for (uint32_t row = 0; row < count; ++row) {
+    if (IsRowVisible(row))
+      rows.push_back(row);
+  }
+  if (sort_keys_.empty())
+    return rows;
+  // Read the sort keys only once, which also makes it safe to compare rows
+  // in other threads.
+  std::vector<std::vector<base::Value>> keys(sort_keys_.size());
+  for (size_t k = 0; k < sort_keys_.size(); ++k) {
+    keys[k].reserve(rows.size());
+    for (uint32_t row : rows)
+      keys[k].push_back(source_->GetValue(sort_keys_[k].column, row));
+  }
+  std::vector<uint32_t> order(rows.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = static_cast<uint32_t>(i);
+  ParallelStableSort(&order, [this, &keys](uint32_t a, uint32_t b) {
+    for (size_t k = 0; k < keys.size(); ++k) {
+      int result = CompareValues(keys[k][a], keys[k][b]);
+      if (result != 0)
+        return sort_keys_[k].ascending ? result < 0 : result > 0;
+    }
+    return false;
+  });
+  for (uint32_t& i : order)
+    i = rows[i];
+  return order;
+}
+
+void ProjectedTableModel::Rebuild() {
+  std::vector<uint32_t> old_rows = std::move(rows_);
+  rows_ = ComputeRows();
+  projected_rows_dirty_ = true;
+  EnsureProjectedRows();
+  const std::vector<int>& new_rows = projected_rows_;
+  NotifyRowsReordered([&old_rows, &new_rows](int row) {
+    if (row < 0 || static_cast<size_t>(row) >= old_rows.size())
+      return -1;
+    uint32_t source_row = old_rows[row];
+    if (source_row >= new_rows.size())
+      return -1;
+    return new_rows[source_row];
+  });
+}
+
+uint32_t ProjectedTableModel::InsertSourceRow(uint32_t source_row) {
+  auto it = std::lower_bound(rows_.begin(), rows_.end(), source_row,
+                             [this](uint32_t a, uint32_t b) {
+                               return IsRowBefore(a, b);
+                             });
+  uint32_t row = static_cast<uint32_t>(it - rows_.begin());
+  rows_.insert(it, source_row);
+  NotifyRowInsertion(row);
+  return row;
+}
+
+void ProjectedTableModel::UpdateSourceRow(uint32_t source_row) {
+  int row = GetProjectedRow(source_row);
+  bool visible = IsRowVisible(source_row);
+  if (row >= 0 && visible) {
+    // Only redraw the row if it is still in order.
+    size_t i = static_cast<size_t>(row);
+    if ((i == 0 || IsRowBefore(rows_[i - 1], source_row)) &&
+        (i + 1 == rows_.size() || IsRowBefore(source_row, rows_[i + 1]))) {
+      NotifyRangeChanged(row, 1);
+      return;
+    }
+  }
+  // Only the rows between the old and new positions shift.
+  size_t start = rows_.size();
+  size_t end = rows_.size();
+  if (row >= 0) {
+    rows_.erase(rows_.begin() + row);
+    if (!projected_rows_dirty_)
+      projected_rows_[source_row] = -1;
+    start = row;
+    NotifyRowDeletion(row);
+  }
+  if (visible) {
+    size_t new_row = InsertSourceRow(source_row);
+    if (row >= 0) {
+      end = std::max(start, new_row) + 1;
+      start = std::min(start, new_row);
+    } else {
+      start = new_row;
+      end = rows_.size();
+    }
+  }
+  UpdateProjectedRows(start, std::min(end, rows_.size()));
+}
+
+bool ProjectedTableModel::IsRowBefore(uint32_t a, uint32_t b) const {
+  for (const SortKey& key : sort_keys_) {
+    int result = CompareValues(source_->GetValue(key.column, a),
+                               source_->GetValue(key.column, b));
+    if (result != 0)
+      return key.ascending ? result < 0 : result > 0;
+  }
+  // Keep the order of source for equal rows.
+  return a < b;
+}
+
+bool ProjectedTableModel::IsRowVisible(uint32_t source_row) const {
+  return !filter_ || filter_(source_.get(), source_row);
+}
+
+void ProjectedTableModel::EnsureProjectedRows() const {
+  if (!projected_rows_dirty_)
+    return;
+  projected_rows_.assign(source_->GetRowCount(), -1);
+  for (size_t i = 0; i < rows_.size(); ++i) {
+    if (rows_[i] < projected_rows_.size())
+      projected_rows_[rows_[i]] = static_cast<int>(i);
+  }
+  projected_rows_dirty_ = false;
+}
+
+void ProjectedTableModel::UpdateProjectedRows(size_t start, size_t end) {
+  if (projected_rows_dirty_)
+    return;
+  for (size_t i = start; i < end; ++i)
+    projected_rows_[rows_[i]] = static_cast<int>(i);
+}
+
+}  // namespace nu
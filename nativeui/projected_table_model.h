@@ -0,0 +1,105 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_PROJECTED_TABLE_MODEL_H_
+#define NATIVEUI_PROJECTED_TABLE_MODEL_H_
+
+#include <functional>
+#include <vector>
+
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+// Show rows of a source model sorted and filtered, without copying data.
+class NATIVEUI_EXPORT ProjectedTableModel : public TableModel,
+                                            public TableModelObserver {
+ public:
+  struct SortKey {
+    uint32_t column = 0;
+    bool ascending = true;
+  };
+
+  // Return whether the |row| of |source| should be shown.
+  using Filter = std::function<bool(TableModel* source, uint32_t row)>;
+
+  explicit ProjectedTableModel(scoped_refptr<TableModel> source);
+
+  // Sort rows by |keys|, earlier keys take precedence. The sort is stable,
+  // rows that compare equal keep their order in source.
+  void SetSortKeys(std::vector<SortKey> keys);
+  const std::vector<SortKey>& GetSortKeys() const { return sort_keys_; }
+
+  // Only show rows that |filter| returns true for, pass an empty function to
+  // show all rows.
+  void SetFilter(Filter filter);
+
+  // Update the projection after |filter| changes its rules.
+  void Refilter();
+
+  TableModel* GetSource() const { return source_.get(); }
+
+  // Translate row indices between the projection and source. -1 is returned
+  // for out of range rows and source rows that are filtered out.
+  int GetSourceRow(uint32_t row) const;
+  int GetProjectedRow(uint32_t source_row) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  const base::Value* GetValueRef(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+ protected:
+  ~ProjectedTableModel() override;
+
+ private:
+  // TableModelObserver, called by source model:
+  void OnRowsInserted(uint32_t start, uint32_t count) override;
+  void OnRowsDeleted(uint32_t start, uint32_t count) override;
+  void OnRangeChanged(uint32_t start, uint32_t count) override;
+  void OnReset() override;
+  void OnValueChanged(uint32_t column, uint32_t row) override;
+
+  // Return the source indices of visible rows in sorted order.
+  std::vector<uint32_t> ComputeRows() const;
+
+  // Compute the rows from scratch and notify tables.
+  void Rebuild();
+
+  // Insert the source row at the position decided by sort keys, and return
+  // the inserted position.
+  uint32_t InsertSourceRow(uint32_t source_row);
+
+  // Move, insert or remove the source row after its data changed.
+  void UpdateSourceRow(uint32_t source_row);
+
+  // Compare two source rows with sort keys.
+  bool IsRowBefore(uint32_t a, uint32_t b) const;
+
+  bool IsRowVisible(uint32_t source_row) const;
+
+  // Build |projected_rows_| if it has been invalidated.
+  void EnsureProjectedRows() const;
+
+  // Refresh |projected_rows_| for rows in [start, end).
+  void UpdateProjectedRows(size_t start, size_t end);
+
+  scoped_refptr<TableModel> source_;
+  std::vector<SortKey> sort_keys_;
+  Filter filter_;
+
+  // The source index of each row.
+  std::vector<uint32_t> rows_;
+
+  // The inverse of |rows_|, the projected index of each source row or -1.
+  // It is rebuilt lazily after source rows are inserted or deleted, and
+  // updated in place when a row moves.
+  mutable std::vector<int> projected_rows_;
+  mutable bool projected_rows_dirty_ = true;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_PROJECTED_TABLE_MODEL_H_
@@ -5,8 +5,11 @@
 #ifndef NATIVEUI_SIGNAL_H_
 #define NATIVEUI_SIGNAL_H_
 
+#include <stdlib.h>
+
 #include <algorithm>
 #include <functional>
+#include <iterator>
 #include <utility>
 #include <vector>
 
@@ -22,10 +25,24 @@ class SignalDelegate {
 };
 
 // A simple signal/slot implementation.
+//
+// Emitting does not copy the slots, instead slots disconnected during an
+// emission are marked as removed by negating their ids and slots connected
+// during an emission are kept in |pending_|, both are merged into |slots_|
+// after the outermost emission returns.
 template<typename Sig> class SignalBase {
  public:
   using Slot = std::function<Sig>;
 
+  ~SignalBase() {
+    // The signal is destroyed inside a slot, hand the slots to the emitter so
+    // the running slot is not freed under it.
+    if (emit_scope_) {
+      emit_scope_->destroyed_ = true;
+      emit_scope_->orphan_ = std::move(slots_);
+    }
+  }
+
   void SetDelegate(SignalDelegate* delegate, int identifier = 0) {
     delegate_ = delegate;
     identifier_ = identifier;
@@ -33,35 +50,115 @@ template<typename Sig> class SignalBase {
 
   int Connect(Slot slot) {
     CHECK(slot);
-    if (delegate_ && slots_.empty())
+    if (delegate_ && IsEmpty())
       delegate_->OnConnect(identifier_);
-    slots_.push_back(std::make_pair(++next_id_, std::move(slot)));
+    if (emit_scope_)
+      pending_.push_back(std::make_pair(++next_id_, std::move(slot)));
+    else
+      slots_.push_back(std::make_pair(++next_id_, std::move(slot)));
     return next_id_;
   }
 
   void Disconnect(int id) {
     auto iter = std::lower_bound(slots_.begin(), slots_.end(),
                                  id, TupleCompare);
-    if (iter != slots_.end() && std::get<0>(*iter) == id)
-      slots_.erase(iter);
+    if (iter != slots_.end() && std::get<0>(*iter) == id) {
+      if (emit_scope_) {
+        iter->first = -id;
+        has_removed_ = true;
+      } else {
+        slots_.erase(iter);
+      }
+      return;
+    }
+    iter = std::lower_bound(pending_.begin(), pending_.end(),
+                            id, TupleCompare);
+    if (iter != pending_.end() && std::get<0>(*iter) == id)
+      pending_.erase(iter);
   }
 
   void DisconnectAll() {
-    slots_.clear();
+    pending_.clear();
+    if (emit_scope_) {
+      for (auto& slot : slots_)
+        slot.first = -std::abs(slot.first);
+      has_removed_ = true;
+    } else {
+      slots_.clear();
+    }
   }
 
   bool IsEmpty() const {
-    return slots_.empty();
+    if (!pending_.empty())
+      return false;
+    if (!has_removed_)
+      return slots_.empty();
+    return std::none_of(slots_.begin(), slots_.end(),
+                        [](const auto& slot) { return slot.first > 0; });
   }
 
  protected:
-  // Use the first element of tuple as comparing key.
+  // Marks an emission on stack, nested emissions form a chain.
+  class EmitScope {
+   public:
+    explicit EmitScope(SignalBase* signal)
+        : signal_(signal), previous_(signal->emit_scope_) {
+      signal_->emit_scope_ = this;
+    }
+
+    ~EmitScope() {
+      if (destroyed_) {
+        // Keep the slots alive until the outermost emission returns.
+        if (previous_) {
+          previous_->destroyed_ = true;
+          previous_->orphan_ = std::move(orphan_);
+        }
+        return;
+      }
+      signal_->emit_scope_ = previous_;
+      if (!previous_)
+        signal_->Compact();
+    }
+
+    // Whether the signal has been destroyed by a slot.
+    bool destroyed() const { return destroyed_; }
+
+   private:
+    friend class SignalBase;
+
+    SignalBase* signal_;
+    EmitScope* previous_;
+    bool destroyed_ = false;
+    std::vector<std::pair<int, Slot>> orphan_;
+  };
+
+  // Use the first element of tuple as comparing key, removed slots have
+  // negative ids so compare with the absolute value.
   static bool TupleCompare(const std::pair<int, Slot>& element, int key) {
-    return element.first < key;
+    return std::abs(element.first) < key;
+  }
+
+  // Apply the changes made during emissions.
+  void Compact() {
+    if (has_removed_) {
+      slots_.erase(std::remove_if(slots_.begin(), slots_.end(),
+                                  [](const auto& slot) {
+                                    return slot.first < 0;
+                                  }),
+                   slots_.end());
+      has_removed_ = false;
+    }
+    if (!pending_.empty()) {
+      std::move(pending_.begin(), pending_.end(), std::back_inserter(slots_));
+      pending_.clear();
+    }
   }
 
   int next_id_ = 0;
   std::vector<std::pair<int, Slot>> slots_;
+  std::vector<std::pair<int, Slot>> pending_;
+  bool has_removed_ = false;
+  EmitScope* emit_scope_ = nullptr;
 
   int identifier_ = 0;
   SignalDelegate* delegate_ = nullptr;
@@ -77,11 +174,18 @@ class Signal<void(Args...)> : public SignalBase<void(Args...)> {
 
   template<typename... EmitArgs>
   void Emit(EmitArgs&&... args) {
-    // Copy the list before iterating, since it is possible that user removes
-    // elements from the list when iterating.
-    auto slots = this->slots_;
-    for (auto& slot : slots)
+    typename Base::EmitScope scope(this);
+    // Slots can not be added or erased during emission, so the size and the
+    // addresses of slots are stable.
+    const size_t count = this->slots_.size();
+    for (size_t i = 0; i < count; ++i) {
+      auto& slot = this->slots_[i];
+      if (slot.first < 0)
+        continue;
       slot.second(std::forward<EmitArgs>(args)...);
+      if (scope.destroyed())
+        return;
+    }
   }
 };
 
@@ -93,12 +197,16 @@ class Signal<bool(Args...)> : public SignalBase<bool(Args...)> {
 
   template<typename... EmitArgs>
   bool Emit(EmitArgs&&... args) {
-    // Copy the list before iterating, since it is possible that user removes
-    // elements from the list when iterating.
-    auto slots = this->slots_;
-    for (auto& slot : slots) {
+    typename Base::EmitScope scope(this);
+    const size_t count = this->slots_.size();
+    for (size_t i = 0; i < count; ++i) {
+      auto& slot = this->slots_[i];
+      if (slot.first < 0)
+        continue;
       if (slot.second(std::forward<EmitArgs>(args)...))
         return true;
+      if (scope.destroyed())
+        return false;
     }
     return false;
   }
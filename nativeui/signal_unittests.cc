@@ -2,6 +2,9 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <memory>
+#include <vector>
+
 #include "base/values.h"
 #include "nativeui/signal.h"
 #include "testing/gtest/include/gtest/gtest.h"
@@ -29,3 +32,114 @@ TEST_F(SignalTest, ZeroCopy) {
   });
   signal.Emit(Copiable());
 }
+
+TEST_F(SignalTest, DisconnectDuringEmit) {
+  nu::Signal<void()> signal;
+  std::vector<int> calls;
+  int second = 0;
+  signal.Connect([&]() {
+    calls.push_back(1);
+    signal.Disconnect(second);
+  });
+  second = signal.Connect([&]() { calls.push_back(2); });
+  signal.Connect([&]() { calls.push_back(3); });
+  signal.Emit();
+  EXPECT_EQ(calls, std::vector<int>({1, 3}));
+  calls.clear();
+  signal.Emit();
+  EXPECT_EQ(calls, std::vector<int>({1, 3}));
+}
+
+TEST_F(SignalTest, DisconnectSelfDuringEmit) {
+  nu::Signal<void()> signal;
+  int id = 0;
+  int count = 0;
+  id = signal.Connect([&]() {
+    signal.Disconnect(id);
+    ++count;
+  });
+  signal.Emit();
+  signal.Emit();
+  EXPECT_EQ(count, 1);
+  EXPECT_TRUE(signal.IsEmpty());
+}
+
+TEST_F(SignalTest, DisconnectAllDuringEmit) {
+  nu::Signal<void()> signal;
+  int count = 0;
+  signal.Connect([&]() {
+    ++count;
+    signal.DisconnectAll();
+    EXPECT_TRUE(signal.IsEmpty());
+  });
+  signal.Connect([&]() { ++count; });
+  signal.Emit();
+  EXPECT_EQ(count, 1);
+  EXPECT_TRUE(signal.IsEmpty());
+}
+
+TEST_F(SignalTest, ConnectDuringEmit) {
+  nu::Signal<void()> signal;
+  int count = 0;
+  int added = 0;
+  signal.Connect([&]() {
+    ++count;
+    int id = signal.Connect([&]() { ++added; });
+    // Slots connected during emission can be disconnected before they run.
+    if (count == 2)
+      signal.Disconnect(id);
+  });
+  signal.Emit();
+  EXPECT_EQ(added, 0);
+  signal.Emit();
+  EXPECT_EQ(added, 1);
+}
+
+TEST_F(SignalTest, NestedEmit) {
+  nu::Signal<bool(int)> signal;
+  std::vector<int> calls;
+  int second = 0;
+  signal.Connect([&](int depth) {
+    calls.push_back(depth);
+    if (depth == 0) {
+      signal.Emit(1);
+      signal.Disconnect(second);
+    }
+    return false;
+  });
+  second = signal.Connect([&](int depth) {
+    calls.push_back(depth + 10);
+    return false;
+  });
+  EXPECT_FALSE(signal.Emit(0));
+  EXPECT_EQ(calls, std::vector<int>({0, 1, 11}));
+}
+
+TEST_F(SignalTest, DestroyDuringEmit) {
+  auto* signal = new nu::Signal<void()>;
+  auto value = std::make_shared<int>(0);
+  bool called = false;
+  signal->Connect([signal, value]() {
+    delete signal;
+    // The captured state must still be alive after the signal is gone.
+    ++*value;
+  });
+  signal->Connect([&]() { called = true; });
+  signal->Emit();
+  EXPECT_EQ(*value, 1);
+  EXPECT_FALSE(called);
+}
+
+// There is no benchmark harness, emit many times with 0, 1 and 8 slots to
+// make sure the emission path stays cheap.
+TEST_F(SignalTest, EmitCost) {
+  for (int slots : {0, 1, 8}) {
+    nu::Signal<void(int)> signal;
+    int sum = 0;
+    for (int i = 0; i < slots; ++i)
+      signal.Connect([&sum](int value) { sum += value; });
+    for (int i = 0; i < 1000000; ++i)
+      signal.Emit(1);
+    EXPECT_EQ(sum, slots * 1000000);
+  }
+}
@@ -13,6 +13,7 @@
 #include "nativeui/notification_center.h"
 #include "nativeui/protocol_job.h"
 #include "nativeui/screen.h"
+#include "nativeui/util/yoga_util.h"
 #include "third_party/yoga/Yoga.h"
 
 #if defined(OS_WIN)
@@ -53,7 +54,7 @@ State* State::GetMain() {
   return g_main_state;
 }
 
-State::State() : yoga_config_(YGConfigNew()) {
+State::State() : yoga_config_(new YogaConfig) {
   DCHECK_EQ(GetCurrent(), nullptr) << "should only have one state per thread";
 
   if (!g_main_state)
@@ -66,7 +67,7 @@ State::State() : yoga_config_(YGConfigNew()) {
 }
 
 State::~State() {
-  YGConfigFree(yoga_config_);
+  yoga_config_ = nullptr;
 
   if (g_main_state == this)
     g_main_state = nullptr;
@@ -11,8 +11,6 @@
 #include "base/memory/ref_counted.h"
 #include "nativeui/app.h"
 
-typedef struct YGConfig *YGConfigRef;
-
 #if defined(OS_WIN)
 namespace base {
 class ScopedNativeLibrary;
@@ -28,6 +26,7 @@ class Appearance;
 class Font;
 class NotificationCenter;
 class Screen;
+class YogaConfig;
 
 #if defined(OS_WIN)
 class ClassRegistrar;
@@ -88,7 +87,7 @@ class NATIVEUI_EXPORT State {
   scoped_refptr<Font>& default_font() { return default_font_; }
 
   // Internal: Return the default yoga config.
-  YGConfigRef yoga_config() const { return yoga_config_; }
+  YogaConfig* yoga_config() const { return yoga_config_.get(); }
 
  private:
   void PlatformInit();
@@ -126,7 +125,7 @@ class NATIVEUI_EXPORT State {
   // The app instance.
   App app_;
 
-  YGConfigRef yoga_config_;
+  scoped_refptr<YogaConfig> yoga_config_;
 };
 
 }  // namespace nu
@@ -0,0 +1,37 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/style.h"
+
+#include "base/logging.h"
+
+namespace nu {
+
+Style::Style(const std::map<std::string, std::string>& properties) {
+  properties_.reserve(properties.size());
+  for (const auto& it : properties) {
+    std::string key(ParseStyleName(it.first));
+    if (key == "color") {
+      color_ = Color(it.second);
+    } else if (key == "backgroundcolor") {
+      background_color_ = Color(it.second);
+    } else {
+      YogaProperty property;
+      if (ParseYogaProperty(key, it.second, &property))
+        properties_.push_back(property);
+      else
+        LOG(WARNING) << "Ignored invalid style property " << it.first;
+    }
+  }
+}
+
+Style::~Style() {
+}
+
+void Style::ApplyTo(YGNodeRef node) const {
+  for (const YogaProperty& property : properties_)
+    ApplyYogaProperty(node, property);
+}
+
+}  // namespace nu
@@ -0,0 +1,46 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_STYLE_H_
+#define NATIVEUI_STYLE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "nativeui/gfx/color.h"
+#include "nativeui/util/yoga_util.h"
+#include "third_party/abseil-cpp/absl/types/optional.h"
+
+namespace nu {
+
+class View;
+
+// A set of style properties that is parsed once and can then be applied to
+// many views without parsing the names and values again.
+class NATIVEUI_EXPORT Style : public base::RefCounted<Style> {
+ public:
+  explicit Style(const std::map<std::string, std::string>& properties);
+
+  // Internal: Apply the layout properties to the yoga node.
+  void ApplyTo(YGNodeRef node) const;
+
+  const absl::optional<Color>& color() const { return color_; }
+  const absl::optional<Color>& background_color() const {
+    return background_color_;
+  }
+
+ private:
+  friend class base::RefCounted<Style>;
+
+  ~Style();
+
+  std::vector<YogaProperty> properties_;
+  absl::optional<Color> color_;
+  absl::optional<Color> background_color_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_STYLE_H_
@@ -6,7 +6,7 @@
 
 #include <utility>
 
-#include "nativeui/table_model.h"
+#include "nativeui/table_search_index.h"
 
 namespace nu {
 
@@ -26,16 +26,18 @@ Table::Table() {
 Table::~Table() {
   PlatformDestroy();
   if (model_)
-    model_->Unsubscribe(this);
+    model_->RemoveObserver(this);
 }
 
 void Table::SetModel(scoped_refptr<TableModel> model) {
   if (model_)
-    model_->Unsubscribe(this);
+    model_->RemoveObserver(this);
   PlatformSetModel(model.get());
   model_ = std::move(model);
   if (model_)
-    model_->Subscribe(this);
+    model_->AddObserver(this);
+  if (search_index_)
+    search_index_->SetModel(model_.get());
 }
 
 TableModel* Table::GetModel() {
@@ -46,8 +48,41 @@ void Table::AddColumn(const std::string& title) {
   AddColumnWithOptions(title, ColumnOptions());
 }
 
+void Table::SetSearchColumn(int column) {
+  if (column == GetSearchColumn())
+    return;
+  if (column < 0) {
+    search_index_.reset();
+  } else {
+    search_index_ = std::make_unique<TableSearchIndex>(column);
+    search_index_->SetModel(model_.get());
+  }
+  PlatformSetSearchColumn(column);
+}
+
+int Table::GetSearchColumn() const {
+  return search_index_ ? static_cast<int>(search_index_->column()) : -1;
+}
+
+std::vector<int> Table::FindRows(const std::string& prefix) {
+  if (!search_index_)
+    return std::vector<int>();
+  return search_index_->FindRows(prefix);
+}
+
 const char* Table::GetClassName() const {
   return kClassName;
 }
 
+void Table::OnRowsReordered(const std::function<int(int)>& map_row) {
+  std::set<int> selection;
+  for (int row : GetSelectedRows()) {
+    int new_row = map_row(row);
+    if (new_row >= 0)
+      selection.insert(new_row);
+  }
+  OnReset();
+  SelectRows(std::move(selection));
+}
+
 }  // namespace nu
@@ -5,21 +5,24 @@
 #ifndef NATIVEUI_TABLE_H_
 #define NATIVEUI_TABLE_H_
 
+#include <memory>
 #include <set>
 #include <string>
+#include <vector>
 
+#include "nativeui/table_model.h"
 #include "nativeui/view.h"
 
-namespace base {
-class Value;
-}
+#if defined(OS_LINUX)
+typedef struct _GtkCellRenderer GtkCellRenderer;
+#endif
 
 namespace nu {
 
 class Painter;
-class TableModel;
+class TableSearchIndex;
 
-class NATIVEUI_EXPORT Table : public View {
+class NATIVEUI_EXPORT Table : public View, public TableModelObserver {
  public:
   enum class ColumnType {
     Text,
@@ -39,6 +42,9 @@ class NATIVEUI_EXPORT Table : public View {
     int column = -1;
     // Initial width.
     int width = -1;
+    // Bytes of memory used for caching rendered cells of Custom column, 0
+    // disables the cache.
+    uint32_t raster_cache_size = 0;
   };
 
   Table();
@@ -65,6 +71,14 @@ class NATIVEUI_EXPORT Table : public View {
   void SelectRows(std::set<int> rows);
   std::set<int> GetSelectedRows() const;
 
+  // Use the values of |column| in model for type-ahead search, -1 disables
+  // the search.
+  void SetSearchColumn(int column);
+  int GetSearchColumn() const;
+
+  // Return rows whose values in the search column start with |prefix|.
+  std::vector<int> FindRows(const std::string& prefix);
+
   // View:
   const char* GetClassName() const override;
 
@@ -78,16 +92,25 @@ class NATIVEUI_EXPORT Table : public View {
   NativeView PlatformCreate();
   void PlatformDestroy();
   void PlatformSetModel(TableModel* model);
+  void PlatformSetSearchColumn(int column);
 
  private:
-  friend class TableModel;
-
-  // Called by TableModel.
-  void NotifyRowInsertion(uint32_t row);
-  void NotifyRowDeletion(uint32_t row);
-  void NotifyValueChange(uint32_t column, uint32_t row);
+  // TableModelObserver:
+  void OnRowsInserted(uint32_t start, uint32_t count) override;
+  void OnRowsDeleted(uint32_t start, uint32_t count) override;
+  void OnRangeChanged(uint32_t start, uint32_t count) override;
+  void OnReset() override;
+  void OnValueChanged(uint32_t column, uint32_t row) override;
+  void OnRowsReordered(const std::function<int(int)>& map_row) override;
 
   scoped_refptr<TableModel> model_;
+  std::unique_ptr<TableSearchIndex> search_index_;
+
+#if defined(OS_LINUX)
+  // Renderers of Custom columns with raster cache, which must be invalidated
+  // when the model changes.
+  std::vector<GtkCellRenderer*> cached_renderers_;
+#endif
 };
 
 }  // namespace nu
@@ -4,13 +4,44 @@
 
 #include "nativeui/table_model.h"
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
 #include <utility>
 
 #include "base/logging.h"
-#include "nativeui/table.h"
 
 namespace nu {
 
+namespace {
+
+// Passed to InvalidateRows to invalidate all rows after start.
+constexpr uint32_t kAllRows = std::numeric_limits<uint32_t>::max();
+
+// AbstractTableModel reads rows by blocks of this size with get_rows.
+constexpr uint32_t kRowsPerBlock = 64;
+
+// How many blocks are cached by AbstractTableModel.
+constexpr size_t kMaxCachedBlocks = 16;
+
+// ColumnarTableModel compacts a string arena when more than half of it, and
+// more than this number of bytes, are no longer referenced.
+constexpr size_t kMinArenaGarbage = 64 * 1024;
+
+}  // namespace
+
+///////////////////////////////////////////////////////////////////////////////
+// TableModelObserver implementation.
+
+void TableModelObserver::OnValueChanged(uint32_t column, uint32_t row) {
+  OnRangeChanged(row, 1);
+}
+
+void TableModelObserver::OnRowsReordered(
+    const std::function<int(int)>& map_row) {
+  OnReset();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // TableModel implementation.
 
@@ -18,29 +49,75 @@ TableModel::TableModel() {}
 
 TableModel::~TableModel() {}
 
+const base::Value* TableModel::GetValueRef(uint32_t column,
+                                           uint32_t row) const {
+  return nullptr;
+}
+
+TreeTableModel* TableModel::AsTreeTableModel() {
+  return nullptr;
+}
+
 void TableModel::NotifyRowInsertion(uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyRowInsertion(row);
+  NotifyRowsInserted(row, 1);
 }
 
 void TableModel::NotifyRowDeletion(uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyRowDeletion(row);
+  NotifyRowsDeleted(row, 1);
 }
 
 void TableModel::NotifyValueChange(uint32_t column, uint32_t row) {
-  for (Table* table : tables_)
-    table->NotifyValueChange(column, row);
+  InvalidateRows(row, 1);
+  for (TableModelObserver* observer : observers_)
+    observer->OnValueChanged(column, row);
+}
+
+void TableModel::NotifyRowsInserted(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  InvalidateRows(start, kAllRows);
+  for (TableModelObserver* observer : observers_)
+    observer->OnRowsInserted(start, count);
 }
 
-void TableModel::Subscribe(Table* view) {
-  tables_.push_back(view);
+void TableModel::NotifyRowsDeleted(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  InvalidateRows(start, kAllRows);
+  for (TableModelObserver* observer : observers_)
+    observer->OnRowsDeleted(start, count);
+}
+
+void TableModel::NotifyRangeChanged(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  InvalidateRows(start, count);
+  for (TableModelObserver* observer : observers_)
+    observer->OnRangeChanged(start, count);
+}
+
+void TableModel::NotifyReset() {
+  InvalidateRows(0, kAllRows);
+  for (TableModelObserver* observer : observers_)
+    observer->OnReset();
+}
+
+void TableModel::NotifyRowsReordered(const std::function<int(int)>& map_row) {
+  InvalidateRows(0, kAllRows);
+  for (TableModelObserver* observer : observers_)
+    observer->OnRowsReordered(map_row);
+}
+
+void TableModel::AddObserver(TableModelObserver* observer) {
+  observers_.push_back(observer);
 }
 
-void TableModel::Unsubscribe(Table* view) {
-  tables_.remove(view);
+void TableModel::RemoveObserver(TableModelObserver* observer) {
+  observers_.remove(observer);
 }
 
+void TableModel::InvalidateRows(uint32_t start, uint32_t count) {}
+
 ///////////////////////////////////////////////////////////////////////////////
 // AbstractTableModel implementation.
 
@@ -57,6 +134,12 @@ uint32_t AbstractTableModel::GetRowCount() const {
 
 base::Value AbstractTableModel::GetValue(
     uint32_t column, uint32_t row) const {
+  if (get_rows) {
+    const base::Value* data = GetCachedRow(row);
+    if (data && data->is_list() && column < data->GetList().size())
+      return data->GetList()[column].Clone();
+    return base::Value();
+  }
   if (!get_value)
     return base::Value();
   if (!index_starts_from_0_) {
@@ -78,6 +161,39 @@ void AbstractTableModel::SetValue(uint32_t column, uint32_t row,
             column, row, std::move(value));
 }
 
+void AbstractTableModel::InvalidateRows(uint32_t start, uint32_t count) {
+  uint64_t end = static_cast<uint64_t>(start) + count;
+  blocks_.remove_if([start, end](const RowsBlock& block) {
+    uint64_t block_start = static_cast<uint64_t>(block.index) * kRowsPerBlock;
+    return block_start < end && block_start + kRowsPerBlock > start;
+  });
+}
+
+const base::Value* AbstractTableModel::GetCachedRow(uint32_t row) const {
+  uint32_t index = row / kRowsPerBlock;
+  auto it = std::find_if(blocks_.begin(), blocks_.end(),
+                         [index](const RowsBlock& block) {
+                           return block.index == index;
+                         });
+  if (it == blocks_.end()) {
+    uint32_t start = index * kRowsPerBlock;
+    if (!index_starts_from_0_)
+      start += 1;
+    base::Value rows = get_rows(const_cast<AbstractTableModel*>(this),
+                                start, kRowsPerBlock);
+    if (!rows.is_list())
+      return nullptr;
+    blocks_.push_front({index, std::move(rows)});
+    if (blocks_.size() > kMaxCachedBlocks)
+      blocks_.pop_back();
+  } else if (it != blocks_.begin()) {
+    blocks_.splice(blocks_.begin(), blocks_, it);
+  }
+  const auto& rows = blocks_.front().rows.GetList();
+  uint32_t offset = row - index * kRowsPerBlock;
+  return offset < rows.size() ? &rows[offset] : nullptr;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // SimpleTableModel implementation.
 
@@ -87,39 +203,484 @@ SimpleTableModel::~SimpleTableModel() {}
 
 void SimpleTableModel::AddRow(Row data) {
   if (data.size() >= columns_) {
-    rows_.emplace_back(std::move(data));
-    NotifyRowInsertion(static_cast<uint32_t>(rows_.size()) - 1);
+    std::vector<Row> rows;
+    rows.emplace_back(std::move(data));
+    DoInsertRows(row_count_, std::move(rows));
+    NotifyRowInsertion(row_count_ - 1);
   } else {
     LOG(ERROR) << "AddRow failed because row length is less than column size.";
   }
 }
 
 void SimpleTableModel::RemoveRowAt(uint32_t row) {
-  if (row >= 0 && row < rows_.size()) {
-    rows_.erase(rows_.begin() + row);
+  if (row >= 0 && row < row_count_) {
+    DoRemoveRows(row, 1);
     NotifyRowDeletion(row);
   } else {
     LOG(ERROR) << "RemoveRow failed because row index is not in model.";
   }
 }
 
+void SimpleTableModel::AddRows(std::vector<Row> rows) {
+  if (!IsValidRows(rows)) {
+    LOG(ERROR) << "AddRows failed because row length is less than column "
+                  "size.";
+    return;
+  }
+  uint32_t start = row_count_;
+  uint32_t count = static_cast<uint32_t>(rows.size());
+  DoInsertRows(start, std::move(rows));
+  NotifyRowsInserted(start, count);
+}
+
+void SimpleTableModel::InsertRows(uint32_t at, std::vector<Row> rows) {
+  if (at > row_count_) {
+    LOG(ERROR) << "InsertRows failed because row index is not in model.";
+    return;
+  }
+  if (!IsValidRows(rows)) {
+    LOG(ERROR) << "InsertRows failed because row length is less than column "
+                  "size.";
+    return;
+  }
+  uint32_t count = static_cast<uint32_t>(rows.size());
+  DoInsertRows(at, std::move(rows));
+  NotifyRowsInserted(at, count);
+}
+
+void SimpleTableModel::RemoveRows(uint32_t start, uint32_t count) {
+  if (start >= row_count_ || count > row_count_ - start) {
+    LOG(ERROR) << "RemoveRows failed because row index is not in model.";
+    return;
+  }
+  DoRemoveRows(start, count);
+  NotifyRowsDeleted(start, count);
+}
+
 uint32_t SimpleTableModel::GetRowCount() const {
-  return static_cast<uint32_t>(rows_.size());
+  return row_count_;
 }
 
 base::Value SimpleTableModel::GetValue(
     uint32_t column, uint32_t row) const {
-  if (columns_ >= 0 && column < columns_ && row >= 0 && row < rows_.size())
-    return rows_[row][column].Clone();
+  if (columns_ >= 0 && column < columns_ && row >= 0 && row < row_count_)
+    return GetRow(row)[column].Clone();
   return base::Value();
 }
 
+const base::Value* SimpleTableModel::GetValueRef(
+    uint32_t column, uint32_t row) const {
+  if (column < columns_ && row < row_count_)
+    return &GetRow(row)[column];
+  return nullptr;
+}
+
 void SimpleTableModel::SetValue(uint32_t column, uint32_t row,
                                 base::Value value) {
-  if (columns_ >= 0 && column < columns_ && row >= 0 && row < rows_.size()) {
-    rows_[row][column] = std::move(value);
+  if (columns_ >= 0 && column < columns_ && row >= 0 && row < row_count_) {
+    GetRow(row)[column] = std::move(value);
     NotifyValueChange(column, row);
   }
 }
 
+bool SimpleTableModel::IsValidRows(const std::vector<Row>& rows) const {
+  for (const Row& data : rows) {
+    if (data.size() < columns_)
+      return false;
+  }
+  return true;
+}
+
+void SimpleTableModel::DoInsertRows(uint32_t at, std::vector<Row> rows) {
+  if (rows.empty())
+    return;
+  size_t index = 0;
+  size_t offset = 0;
+  if (chunks_.empty()) {
+    chunks_.emplace_back();
+  } else if (at == row_count_) {
+    index = chunks_.size() - 1;
+    offset = chunks_[index].size();
+  } else {
+    index = FindChunk(at);
+    offset = at - chunk_starts_[index];
+  }
+  std::vector<Row>& chunk = chunks_[index];
+  chunk.insert(chunk.begin() + offset,
+               std::make_move_iterator(rows.begin()),
+               std::make_move_iterator(rows.end()));
+  row_count_ += static_cast<uint32_t>(rows.size());
+  // Split the chunk into half-full ones when it grows too large, so following
+  // insertions do not have to split again immediately.
+  if (chunk.size() > kMaxChunkRows) {
+    size_t pieces = chunk.size() / (kMaxChunkRows / 2);
+    std::vector<std::vector<Row>> split(pieces);
+    size_t begin = 0;
+    for (size_t i = 0; i < pieces; ++i) {
+      size_t end = chunk.size() * (i + 1) / pieces;
+      split[i].reserve(kMaxChunkRows);
+      split[i].assign(std::make_move_iterator(chunk.begin() + begin),
+                      std::make_move_iterator(chunk.begin() + end));
+      begin = end;
+    }
+    chunks_.erase(chunks_.begin() + index);
+    chunks_.insert(chunks_.begin() + index,
+                   std::make_move_iterator(split.begin()),
+                   std::make_move_iterator(split.end()));
+  }
+  UpdateChunkStarts(index);
+}
+
+void SimpleTableModel::DoRemoveRows(uint32_t start, uint32_t count) {
+  if (count == 0)
+    return;
+  size_t first = FindChunk(start);
+  size_t offset = start - chunk_starts_[first];
+  size_t index = first;
+  for (uint32_t remaining = count; remaining > 0; ++index) {
+    std::vector<Row>& chunk = chunks_[index];
+    size_t n = std::min<size_t>(remaining, chunk.size() - offset);
+    chunk.erase(chunk.begin() + offset, chunk.begin() + offset + n);
+    remaining -= static_cast<uint32_t>(n);
+    offset = 0;
+  }
+  row_count_ -= count;
+  chunks_.erase(std::remove_if(chunks_.begin() + first,
+                               chunks_.begin() + index,
+                               [](const std::vector<Row>& chunk) {
+                                 return chunk.empty();
+                               }),
+                chunks_.begin() + index);
+  // The removal may leave small chunks at both sides, merge them.
+  if (first > 0)
+    --first;
+  if (first + 1 < chunks_.size() &&
+      chunks_[first].size() + chunks_[first + 1].size() <= kMaxChunkRows / 2) {
+    std::vector<Row>& next = chunks_[first + 1];
+    chunks_[first].insert(chunks_[first].end(),
+                          std::make_move_iterator(next.begin()),
+                          std::make_move_iterator(next.end()));
+    chunks_.erase(chunks_.begin() + first + 1);
+  }
+  UpdateChunkStarts(first);
+}
+
+size_t SimpleTableModel::FindChunk(uint32_t row) const {
+  auto it = std::upper_bound(chunk_starts_.begin(), chunk_starts_.end(), row);
+  return it - chunk_starts_.begin() - 1;
+}
+
+void SimpleTableModel::UpdateChunkStarts(size_t index) {
+  chunk_starts_.resize(chunks_.size());
+  index = std::min(index, chunks_.size());
+  uint32_t start = 0;
+  if (index > 0)
+    start = chunk_starts_[index - 1] +
+            static_cast<uint32_t>(chunks_[index - 1].size());
+  for (size_t i = index; i < chunks_.size(); ++i) {
+    chunk_starts_[i] = start;
+    start += static_cast<uint32_t>(chunks_[i].size());
+  }
+}
+
+SimpleTableModel::Row& SimpleTableModel::GetRow(uint32_t row) {
+  size_t index = FindChunk(row);
+  return chunks_[index][row - chunk_starts_[index]];
+}
+
+const SimpleTableModel::Row& SimpleTableModel::GetRow(uint32_t row) const {
+  size_t index = FindChunk(row);
+  return chunks_[index][row - chunk_starts_[index]];
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// ColumnarTableModel implementation.
+
+ColumnarTableModel::Column::Column(ColumnType type) : type(type) {}
+
+ColumnarTableModel::Column::Column(Column&& other) = default;
+
+ColumnarTableModel::Column::~Column() {}
+
+size_t ColumnarTableModel::Column::size() const {
+  switch (type) {
+    case ColumnType::Int64:
+      return ints.size();
+    case ColumnType::Double:
+      return doubles.size();
+    case ColumnType::Bool:
+      return bools.size();
+    case ColumnType::String:
+      return strings.size();
+  }
+  NOTREACHED();
+  return 0;
+}
+
+void ColumnarTableModel::Column::CompactArena() {
+  std::string compacted;
+  compacted.reserve(arena.size() - garbage);
+  for (auto& range : strings) {
+    size_t offset = compacted.size();
+    compacted.append(arena, range.first, range.second);
+    range.first = offset;
+  }
+  arena = std::move(compacted);
+  garbage = 0;
+}
+
+ColumnarTableModel::ColumnarTableModel(std::vector<ColumnType> types) {
+  columns_.reserve(types.size());
+  for (ColumnType type : types)
+    columns_.emplace_back(type);
+}
+
+ColumnarTableModel::~ColumnarTableModel() {}
+
+void ColumnarTableModel::AppendInt64s(uint32_t column,
+                                      const int64_t* data,
+                                      size_t count) {
+  Column* c = GetColumn(column, ColumnType::Int64);
+  if (!c) {
+    LOG(ERROR) << "AppendInt64s failed because column is not int64.";
+    return;
+  }
+  c->ints.insert(c->ints.end(), data, data + count);
+  UpdateRowCount();
+}
+
+void ColumnarTableModel::AppendDoubles(uint32_t column,
+                                       const double* data,
+                                       size_t count) {
+  Column* c = GetColumn(column, ColumnType::Double);
+  if (!c) {
+    LOG(ERROR) << "AppendDoubles failed because column is not double.";
+    return;
+  }
+  c->doubles.insert(c->doubles.end(), data, data + count);
+  UpdateRowCount();
+}
+
+void ColumnarTableModel::AppendBools(uint32_t column,
+                                     const uint8_t* data,
+                                     size_t count) {
+  Column* c = GetColumn(column, ColumnType::Bool);
+  if (!c) {
+    LOG(ERROR) << "AppendBools failed because column is not bool.";
+    return;
+  }
+  c->bools.insert(c->bools.end(), data, data + count);
+  UpdateRowCount();
+}
+
+void ColumnarTableModel::AppendStrings(uint32_t column,
+                                       const std::vector<std::string>& data) {
+  Column* c = GetColumn(column, ColumnType::String);
+  if (!c) {
+    LOG(ERROR) << "AppendStrings failed because column is not string.";
+    return;
+  }
+  size_t total = 0;
+  for (const std::string& str : data)
+    total += str.size();
+  c->arena.reserve(c->arena.size() + total);
+  c->strings.reserve(c->strings.size() + data.size());
+  for (const std::string& str : data) {
+    c->strings.emplace_back(c->arena.size(), static_cast<uint32_t>(str.size()));
+    c->arena.append(str);
+  }
+  UpdateRowCount();
+}
+
+void ColumnarTableModel::AppendPackedStrings(uint32_t column,
+                                             const char* data,
+                                             const uint32_t* offsets,
+                                             size_t count) {
+  Column* c = GetColumn(column, ColumnType::String);
+  if (!c) {
+    LOG(ERROR) << "AppendPackedStrings failed because column is not string.";
+    return;
+  }
+  if (count == 0)
+    return;
+  // The strings can be copied into the arena in one go since they are
+  // already stored contiguously.
+  size_t base = c->arena.size();
+  c->arena.append(data + offsets[0], offsets[count] - offsets[0]);
+  c->strings.reserve(c->strings.size() + count);
+  for (size_t i = 0; i < count; ++i) {
+    c->strings.emplace_back(base + offsets[i] - offsets[0],
+                            offsets[i + 1] - offsets[i]);
+  }
+  UpdateRowCount();
+}
+
+void ColumnarTableModel::Clear() {
+  for (Column& c : columns_) {
+    c.ints.clear();
+    c.doubles.clear();
+    c.bools.clear();
+    c.arena.clear();
+    c.strings.clear();
+    c.garbage = 0;
+  }
+  row_count_ = 0;
+  NotifyReset();
+}
+
+void ColumnarTableModel::SetColumnFormatter(uint32_t column,
+                                            Formatter formatter) {
+  if (column < columns_.size())
+    columns_[column].formatter = std::move(formatter);
+}
+
+uint32_t ColumnarTableModel::GetColumnCount() const {
+  return static_cast<uint32_t>(columns_.size());
+}
+
+ColumnarTableModel::ColumnType ColumnarTableModel::GetColumnType(
+    uint32_t column) const {
+  DCHECK_LT(column, columns_.size());
+  return columns_[column].type;
+}
+
+int64_t ColumnarTableModel::GetInt64(uint32_t column, uint32_t row) const {
+  const Column* c = GetColumn(column, ColumnType::Int64);
+  if (!c || row >= row_count_)
+    return 0;
+  return c->ints[row];
+}
+
+double ColumnarTableModel::GetDouble(uint32_t column, uint32_t row) const {
+  const Column* c = GetColumn(column, ColumnType::Double);
+  if (!c || row >= row_count_)
+    return 0;
+  return c->doubles[row];
+}
+
+bool ColumnarTableModel::GetBool(uint32_t column, uint32_t row) const {
+  const Column* c = GetColumn(column, ColumnType::Bool);
+  if (!c || row >= row_count_)
+    return false;
+  return c->bools[row];
+}
+
+base::StringPiece ColumnarTableModel::GetString(uint32_t column,
+                                                uint32_t row) const {
+  const Column* c = GetColumn(column, ColumnType::String);
+  if (!c || row >= row_count_)
+    return base::StringPiece();
+  const auto& range = c->strings[row];
+  return base::StringPiece(c->arena.data() + range.first, range.second);
+}
+
+uint32_t ColumnarTableModel::GetRowCount() const {
+  return row_count_;
+}
+
+base::Value ColumnarTableModel::GetValue(uint32_t column, uint32_t row) const {
+  if (column >= columns_.size() || row >= row_count_)
+    return base::Value();
+  const Column& c = columns_[column];
+  base::Value value;
+  switch (c.type) {
+    case ColumnType::Int64: {
+      // base::Value can only store 32bit integers.
+      int64_t i = c.ints[row];
+      if (i >= std::numeric_limits<int>::min() &&
+          i <= std::numeric_limits<int>::max())
+        value = base::Value(static_cast<int>(i));
+      else
+        value = base::Value(static_cast<double>(i));
+      break;
+    }
+    case ColumnType::Double:
+      value = base::Value(c.doubles[row]);
+      break;
+    case ColumnType::Bool:
+      value = base::Value(c.bools[row] != 0);
+      break;
+    case ColumnType::String:
+      value = base::Value(GetString(column, row));
+      break;
+  }
+  if (c.formatter)
+    return c.formatter(std::move(value));
+  return value;
+}
+
+void ColumnarTableModel::SetValue(uint32_t column, uint32_t row,
+                                  base::Value value) {
+  if (column >= columns_.size() || row >= row_count_)
+    return;
+  Column& c = columns_[column];
+  switch (c.type) {
+    case ColumnType::Int64:
+      if (value.is_int())
+        c.ints[row] = value.GetInt();
+      else if (value.is_double())
+        c.ints[row] = static_cast<int64_t>(value.GetDouble());
+      else
+        return;
+      break;
+    case ColumnType::Double:
+      if (!value.is_int() && !value.is_double())
+        return;
+      c.doubles[row] = value.GetDouble();
+      break;
+    case ColumnType::Bool:
+      if (!value.is_bool())
+        return;
+      c.bools[row] = value.GetBool();
+      break;
+    case ColumnType::String: {
+      if (!value.is_string())
+        return;
+      const std::string& str = value.GetString();
+      auto& range = c.strings[row];
+      if (str.size() <= range.second) {
+        // Overwrite in place when the new string fits.
+        c.arena.replace(range.first, str.size(), str);
+        c.garbage += range.second - str.size();
+        range.second = static_cast<uint32_t>(str.size());
+      } else {
+        // The old string is left in the arena until the arena is compacted.
+        c.garbage += range.second;
+        range = std::make_pair(c.arena.size(),
+                               static_cast<uint32_t>(str.size()));
+        c.arena.append(str);
+      }
+      if (c.garbage > kMinArenaGarbage && c.garbage > c.arena.size() / 2)
+        c.CompactArena();
+      break;
+    }
+  }
+  NotifyValueChange(column, row);
+}
+
+ColumnarTableModel::Column* ColumnarTableModel::GetColumn(uint32_t column,
+                                                          ColumnType type) {
+  if (column >= columns_.size() || columns_[column].type != type)
+    return nullptr;
+  return &columns_[column];
+}
+
+const ColumnarTableModel::Column* ColumnarTableModel::GetColumn(
+    uint32_t column, ColumnType type) const {
+  if (column >= columns_.size() || columns_[column].type != type)
+    return nullptr;
+  return &columns_[column];
+}
+
+void ColumnarTableModel::UpdateRowCount() {
+  size_t count = std::numeric_limits<size_t>::max();
+  for (const Column& c : columns_)
+    count = std::min(count, c.size());
+  if (columns_.empty() || count <= row_count_)
+    return;
+  uint32_t start = row_count_;
+  row_count_ = static_cast<uint32_t>(count);
+  NotifyRowsInserted(start, row_count_ - start);
+}
+
 }  // namespace nu
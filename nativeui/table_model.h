@@ -7,15 +7,36 @@
 
 #include <functional>
 #include <list>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
 #include "base/values.h"
 #include "nativeui/nativeui_export.h"
 
 namespace nu {
 
-class Table;
+class TreeTableModel;
+
+// Interface for objects that follow the changes of a TableModel, like the
+// tables showing it and the models projecting it.
+class TableModelObserver {
+ public:
+  virtual void OnRowsInserted(uint32_t start, uint32_t count) = 0;
+  virtual void OnRowsDeleted(uint32_t start, uint32_t count) = 0;
+  virtual void OnRangeChanged(uint32_t start, uint32_t count) = 0;
+  virtual void OnReset() = 0;
+
+  // The default implementations treat a single value change as a change of
+  // the row, and reordering as reset.
+  virtual void OnValueChanged(uint32_t column, uint32_t row);
+  virtual void OnRowsReordered(const std::function<int(int)>& map_row);
+
+ protected:
+  virtual ~TableModelObserver() {}
+};
 
 // Users should sublcass TableModel to provide their own implementation.
 class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
@@ -26,27 +47,51 @@ class NATIVEUI_EXPORT TableModel : public base::RefCounted<TableModel> {
   // Return the reference to the data in the model.
   virtual base::Value GetValue(uint32_t column, uint32_t row) const = 0;
 
+  // Return a pointer to the data stored in the model without copying it, the
+  // pointer is only valid until the model is changed. Models that do not
+  // store base::Value return nullptr, and GetValue is used instead.
+  virtual const base::Value* GetValueRef(uint32_t column, uint32_t row) const;
+
   // Change the value.
   virtual void SetValue(uint32_t column, uint32_t row, base::Value value) = 0;
 
+  // Internal: Return the model if it shows a tree, used by tables to show the
+  // tree structure natively.
+  virtual TreeTableModel* AsTreeTableModel();
+
   // Called by sublcass to notify when there rows inserted.
   void NotifyRowInsertion(uint32_t row);
   void NotifyRowDeletion(uint32_t row);
   void NotifyValueChange(uint32_t column, uint32_t row);
 
+  // Notify changes of |count| rows starting from |start| at once.
+  void NotifyRowsInserted(uint32_t start, uint32_t count);
+  void NotifyRowsDeleted(uint32_t start, uint32_t count);
+  void NotifyRangeChanged(uint32_t start, uint32_t count);
+
+  // Notify that the whole model has been changed.
+  void NotifyReset();
+
+  // Notify that rows have been moved, |map_row| returns the new index of an
+  // old row, or -1 if the row has been removed. Selections are kept.
+  void NotifyRowsReordered(const std::function<int(int)>& map_row);
+
+  // Observers are not owned, and must remove themselves before destruction.
+  void AddObserver(TableModelObserver* observer);
+  void RemoveObserver(TableModelObserver* observer);
+
  protected:
   TableModel();
   virtual ~TableModel();
 
+  // Called before tables are notified that |count| rows from |start| have
+  // changed, subclasses caching the data should drop it.
+  virtual void InvalidateRows(uint32_t start, uint32_t count);
+
  private:
   friend class base::RefCounted<TableModel>;
-  friend class Table;
 
-  // Called by table.
-  void Subscribe(Table* view);
-  void Unsubscribe(Table* view);
-
-  std::list<Table*> tables_;
+  std::list<TableModelObserver*> observers_;
 };
 
 // Used by language bindings.
@@ -65,13 +110,31 @@ class NATIVEUI_EXPORT AbstractTableModel : public TableModel {
   std::function<base::Value(AbstractTableModel*, uint32_t, uint32_t)> get_value;
   std::function<void(AbstractTableModel*,
                      uint32_t, uint32_t, base::Value)> set_value;
+  // Optional, return a list of rows starting from |start|, which is used
+  // instead of get_value to read the data block by block.
+  std::function<base::Value(AbstractTableModel*,
+                            uint32_t start, uint32_t count)> get_rows;
 
  protected:
   ~AbstractTableModel() override;
 
+  // TableModel:
+  void InvalidateRows(uint32_t start, uint32_t count) override;
+
  private:
+  struct RowsBlock {
+    uint32_t index;
+    base::Value rows;
+  };
+
+  // Return the row from cached blocks, read the block if not cached.
+  const base::Value* GetCachedRow(uint32_t row) const;
+
   bool index_starts_from_0_;
   base::Value copy_;
+
+  // Blocks read by get_rows, most recently used first.
+  mutable std::list<RowsBlock> blocks_;
 };
 
 // A simple implementation of TableModel that manages the data.
@@ -84,17 +147,129 @@ class NATIVEUI_EXPORT SimpleTableModel : public TableModel {
   void AddRow(Row data);
   void RemoveRowAt(uint32_t row);
 
+  // Add or remove multiple rows with only one notification.
+  void AddRows(std::vector<Row> rows);
+  void InsertRows(uint32_t at, std::vector<Row> rows);
+  void RemoveRows(uint32_t start, uint32_t count);
+
   // TableModel:
   uint32_t GetRowCount() const override;
   base::Value GetValue(uint32_t column, uint32_t row) const override;
+  const base::Value* GetValueRef(uint32_t column, uint32_t row) const override;
   void SetValue(uint32_t column, uint32_t row, base::Value value) override;
 
  protected:
   ~SimpleTableModel() override;
 
  private:
+  // Rows are stored in chunks so inserting or removing rows in the middle
+  // only moves the rows of one chunk.
+  static constexpr size_t kMaxChunkRows = 1024;
+
+  bool IsValidRows(const std::vector<Row>& rows) const;
+  void DoInsertRows(uint32_t at, std::vector<Row> rows);
+  void DoRemoveRows(uint32_t start, uint32_t count);
+
+  // Return the index of chunk that includes |row|.
+  size_t FindChunk(uint32_t row) const;
+  // Recompute the first rows of chunks starting from |index|.
+  void UpdateChunkStarts(size_t index);
+
+  Row& GetRow(uint32_t row);
+  const Row& GetRow(uint32_t row) const;
+
   const uint32_t columns_;
-  std::vector<Row> rows_;
+  uint32_t row_count_ = 0;
+  std::vector<std::vector<Row>> chunks_;
+  std::vector<uint32_t> chunk_starts_;
+};
+
+// A TableModel that stores each column in a contiguous typed array, cells are
+// only converted to base::Value when they are requested by the table.
+class NATIVEUI_EXPORT ColumnarTableModel : public TableModel {
+ public:
+  enum class ColumnType {
+    Int64,
+    Double,
+    Bool,
+    String,
+  };
+
+  // Convert the value of a cell for display.
+  using Formatter = std::function<base::Value(base::Value)>;
+
+  explicit ColumnarTableModel(std::vector<ColumnType> types);
+
+  // Append |count| values to the end of |column|, the type of the column must
+  // match. A row only becomes visible in the model after all its columns have
+  // been appended, so the table is notified once per complete batch of rows.
+  void AppendInt64s(uint32_t column, const int64_t* data, size_t count);
+  void AppendDoubles(uint32_t column, const double* data, size_t count);
+  void AppendBools(uint32_t column, const uint8_t* data, size_t count);
+  void AppendStrings(uint32_t column, const std::vector<std::string>& data);
+
+  // Append |count| strings stored back to back in |data|, the Nth string
+  // starts at offsets[N] and ends at offsets[N + 1].
+  void AppendPackedStrings(uint32_t column,
+                           const char* data,
+                           const uint32_t* offsets,
+                           size_t count);
+
+  // Remove all rows.
+  void Clear();
+
+  void SetColumnFormatter(uint32_t column, Formatter formatter);
+
+  uint32_t GetColumnCount() const;
+  ColumnType GetColumnType(uint32_t column) const;
+
+  // Typed access to the cells without creating base::Value, the type of the
+  // column must match.
+  int64_t GetInt64(uint32_t column, uint32_t row) const;
+  double GetDouble(uint32_t column, uint32_t row) const;
+  bool GetBool(uint32_t column, uint32_t row) const;
+  base::StringPiece GetString(uint32_t column, uint32_t row) const;
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+
+ protected:
+  ~ColumnarTableModel() override;
+
+ private:
+  struct Column {
+    explicit Column(ColumnType type);
+    Column(Column&& other);
+    ~Column();
+
+    size_t size() const;
+
+    // Rewrite the arena with only the strings still referenced.
+    void CompactArena();
+
+    ColumnType type;
+    std::vector<int64_t> ints;
+    std::vector<double> doubles;
+    std::vector<uint8_t> bools;
+    // Strings are stored in one arena, each cell records a range in it.
+    std::string arena;
+    std::vector<std::pair<size_t, uint32_t>> strings;
+    // Bytes in the arena no longer referenced by any cell.
+    size_t garbage = 0;
+    Formatter formatter;
+  };
+
+  // Return the column if it exists and has |type|.
+  Column* GetColumn(uint32_t column, ColumnType type);
+  const Column* GetColumn(uint32_t column, ColumnType type) const;
+
+  // Called after appending to update row count and notify tables.
+  void UpdateRowCount();
+
+  std::vector<Column> columns_;
+  uint32_t row_count_ = 0;
 };
 
 }  // namespace nu
@@ -0,0 +1,194 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/table_search_index.h"
+
+#include <algorithm>
+
+#include "base/strings/string_number_conversions.h"
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+namespace {
+
+// Changes touching more rows than this are handled by rebuilding the index.
+constexpr uint32_t kMaxIncrementalRows = 64;
+
+}  // namespace
+
+TableSearchIndex::TableSearchIndex(uint32_t column) : column_(column) {}
+
+TableSearchIndex::~TableSearchIndex() {
+  SetModel(nullptr);
+}
+
+void TableSearchIndex::SetModel(TableModel* model) {
+  if (model_)
+    model_->RemoveObserver(this);
+  model_ = model;
+  if (model_)
+    model_->AddObserver(this);
+  OnReset();
+}
+
+const std::vector<int>& TableSearchIndex::FindRows(const std::string& prefix) {
+  std::string key = base::ToLowerASCII(prefix);
+  if (has_result_ && key == last_prefix_)
+    return result_;
+  if (dirty_)
+    Rebuild();
+  else
+    MergeAppendedRows();
+  result_.clear();
+  auto it = std::lower_bound(
+      sorted_rows_.begin(), sorted_rows_.end(), key,
+      [this](uint32_t row, const std::string& key) {
+        return keys_[row] < key;
+      });
+  for (; it != sorted_rows_.end(); ++it) {
+    if (!base::StartsWith(keys_[*it], key))
+      break;
+    result_.push_back(static_cast<int>(*it));
+  }
+  std::sort(result_.begin(), result_.end());
+  last_prefix_ = std::move(key);
+  has_result_ = true;
+  return result_;
+}
+
+void TableSearchIndex::OnRowsInserted(uint32_t start, uint32_t count) {
+  InvalidateResult();
+  if (dirty_)
+    return;
+  // Rows inserted in the middle shift the indices of all following rows,
+  // which costs as much as a rebuild.
+  if (start != keys_.size()) {
+    dirty_ = true;
+    return;
+  }
+  for (uint32_t row = start; row < start + count; ++row)
+    keys_.push_back(ReadKey(row));
+}
+
+void TableSearchIndex::OnRowsDeleted(uint32_t start, uint32_t count) {
+  InvalidateResult();
+  if (dirty_)
+    return;
+  // Only appended rows can be removed without touching |sorted_rows_|.
+  if (start < sorted_count_) {
+    dirty_ = true;
+    return;
+  }
+  keys_.erase(keys_.begin() + start, keys_.begin() + start + count);
+}
+
+void TableSearchIndex::OnValueChanged(uint32_t column, uint32_t row) {
+  if (column != column_)
+    return;
+  OnRangeChanged(row, 1);
+}
+
+void TableSearchIndex::OnRangeChanged(uint32_t start, uint32_t count) {
+  InvalidateResult();
+  if (dirty_)
+    return;
+  if (count > kMaxIncrementalRows) {
+    dirty_ = true;
+    return;
+  }
+  for (uint32_t row = start; row < start + count; ++row) {
+    if (row >= sorted_count_) {
+      keys_[row] = ReadKey(row);
+      continue;
+    }
+    EraseSorted(row);
+    keys_[row] = ReadKey(row);
+    InsertSorted(row);
+  }
+}
+
+void TableSearchIndex::OnReset() {
+  InvalidateResult();
+  dirty_ = true;
+  keys_.clear();
+  sorted_rows_.clear();
+  sorted_count_ = 0;
+}
+
+std::string TableSearchIndex::ReadKey(uint32_t row) const {
+  const base::Value* ref = model_->GetValueRef(column_, row);
+  base::Value value;
+  if (!ref) {
+    value = model_->GetValue(column_, row);
+    ref = &value;
+  }
+  switch (ref->type()) {
+    case base::Value::Type::STRING:
+      return base::ToLowerASCII(ref->GetString());
+    case base::Value::Type::INTEGER:
+      return base::NumberToString(ref->GetInt());
+    case base::Value::Type::DOUBLE:
+      return base::NumberToString(ref->GetDouble());
+    default:
+      return std::string();
+  }
+}
+
+void TableSearchIndex::Rebuild() {
+  dirty_ = false;
+  uint32_t count = model_ ? model_->GetRowCount() : 0;
+  keys_.resize(count);
+  sorted_rows_.resize(count);
+  for (uint32_t row = 0; row < count; ++row) {
+    keys_[row] = ReadKey(row);
+    sorted_rows_[row] = row;
+  }
+  std::sort(sorted_rows_.begin(), sorted_rows_.end(),
+            [this](uint32_t a, uint32_t b) { return IsRowBefore(a, b); });
+  sorted_count_ = count;
+}
+
+void TableSearchIndex::MergeAppendedRows() {
+  uint32_t count = static_cast<uint32_t>(keys_.size());
+  if (sorted_count_ == count)
+    return;
+  auto less = [this](uint32_t a, uint32_t b) { return IsRowBefore(a, b); };
+  size_t middle = sorted_rows_.size();
+  for (uint32_t row = sorted_count_; row < count; ++row)
+    sorted_rows_.push_back(row);
+  std::sort(sorted_rows_.begin() + middle, sorted_rows_.end(), less);
+  std::inplace_merge(sorted_rows_.begin(), sorted_rows_.begin() + middle,
+                     sorted_rows_.end(), less);
+  sorted_count_ = count;
+}
+
+void TableSearchIndex::InvalidateResult() {
+  has_result_ = false;
+  result_.clear();
+}
+
+void TableSearchIndex::InsertSorted(uint32_t row) {
+  auto it = std::lower_bound(
+      sorted_rows_.begin(), sorted_rows_.end(), row,
+      [this](uint32_t a, uint32_t b) { return IsRowBefore(a, b); });
+  sorted_rows_.insert(it, row);
+}
+
+void TableSearchIndex::EraseSorted(uint32_t row) {
+  auto it = std::lower_bound(
+      sorted_rows_.begin(), sorted_rows_.end(), row,
+      [this](uint32_t a, uint32_t b) { return IsRowBefore(a, b); });
+  if (it != sorted_rows_.end() && *it == row)
+    sorted_rows_.erase(it);
+}
+
+bool TableSearchIndex::IsRowBefore(uint32_t a, uint32_t b) const {
+  int result = keys_[a].compare(keys_[b]);
+  return result < 0 || (result == 0 && a < b);
+}
+
+}  // namespace nu
@@ -0,0 +1,80 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TABLE_SEARCH_INDEX_H_
+#define NATIVEUI_TABLE_SEARCH_INDEX_H_
+
+#include <string>
+#include <vector>
+
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+// Sorted index of the values of one column, used for finding rows by prefix
+// without reading the whole model. The index is built on first search and
+// then kept updated by notifications of the model. Appended rows are merged
+// into the index on next search, while inserting or deleting rows in the
+// middle makes the index rebuilt on next search.
+class NATIVEUI_EXPORT TableSearchIndex : public TableModelObserver {
+ public:
+  explicit TableSearchIndex(uint32_t column);
+  ~TableSearchIndex() override;
+
+  TableSearchIndex(const TableSearchIndex&) = delete;
+  TableSearchIndex& operator=(const TableSearchIndex&) = delete;
+
+  void SetModel(TableModel* model);
+
+  // Return the rows whose values start with |prefix| in ascending order,
+  // letters are compared case-insensitively. The result is valid until next
+  // search or change of the model.
+  const std::vector<int>& FindRows(const std::string& prefix);
+
+  uint32_t column() const { return column_; }
+
+  // TableModelObserver:
+  void OnRowsInserted(uint32_t start, uint32_t count) override;
+  void OnRowsDeleted(uint32_t start, uint32_t count) override;
+  void OnRangeChanged(uint32_t start, uint32_t count) override;
+  void OnReset() override;
+  void OnValueChanged(uint32_t column, uint32_t row) override;
+
+ private:
+  std::string ReadKey(uint32_t row) const;
+  void Rebuild();
+  void InvalidateResult();
+
+  // Merge the rows appended since last search into |sorted_rows_|.
+  void MergeAppendedRows();
+
+  // Add or remove |row| in |sorted_rows_|, with the key in |keys_|.
+  void InsertSorted(uint32_t row);
+  void EraseSorted(uint32_t row);
+
+  // Order rows by their keys, and then by the rows themselves.
+  bool IsRowBefore(uint32_t a, uint32_t b) const;
+
+  const uint32_t column_;
+  TableModel* model_ = nullptr;
+
+  // The index is rebuilt on next search when it is dirty.
+  bool dirty_ = true;
+
+  // Key of each row.
+  std::vector<std::string> keys_;
+  // Rows before |sorted_count_| sorted by keys, the rows after it have been
+  // appended and are not in |sorted_rows_| yet.
+  std::vector<uint32_t> sorted_rows_;
+  uint32_t sorted_count_ = 0;
+
+  // Result of the last search.
+  std::string last_prefix_;
+  bool has_result_ = false;
+  std::vector<int> result_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TABLE_SEARCH_INDEX_H_
@@ -2,10 +2,16 @@
 // Use of this source code is governed by the license that can be found in the
 // LICENSE file.
 
+#include <map>
+
 #include "base/strings/stringprintf.h"
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
 
+#if defined(OS_LINUX)
+#include "nativeui/gtk/table/cell_raster_cache.h"
+#endif
+
 class TableTest : public testing::Test {
  protected:
   void SetUp() override {
@@ -70,3 +76,564 @@ TEST_F(TableTest, SelectMultipleRows) {
   table_->SelectRows({});
   EXPECT_EQ(table_->GetSelectedRows(), std::set<int>());
 }
+
+TEST_F(TableTest, BulkRows) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  std::vector<nu::SimpleTableModel::Row> rows;
+  for (int i = 0; i < 1000; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(i);
+    rows.push_back(std::move(row));
+  }
+  model->AddRows(std::move(rows));
+  EXPECT_EQ(model->GetRowCount(), 1000u);
+  table_->SelectRow(500);
+  model->RemoveRows(0, 300);
+  EXPECT_EQ(model->GetRowCount(), 700u);
+  EXPECT_EQ(model->GetValue(0, 0), base::Value(300));
+#if defined(OS_LINUX) || defined(OS_MAC)
+  EXPECT_EQ(table_->GetSelectedRow(), 200);
+#endif
+  model->RemoveRows(600, 200);
+  EXPECT_EQ(model->GetRowCount(), 700u);
+}
+
+TEST_F(TableTest, InsertRows) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  auto make_rows = [](int begin, int end) {
+    std::vector<nu::SimpleTableModel::Row> rows;
+    for (int i = begin; i < end; ++i) {
+      nu::SimpleTableModel::Row row;
+      row.emplace_back(i);
+      rows.push_back(std::move(row));
+    }
+    return rows;
+  };
+  model->AddRows(make_rows(0, 3000));
+  model->InsertRows(1500, make_rows(10000, 12000));
+  ASSERT_EQ(model->GetRowCount(), 5000u);
+  EXPECT_EQ(model->GetValue(0, 1499), base::Value(1499));
+  EXPECT_EQ(model->GetValue(0, 1500), base::Value(10000));
+  EXPECT_EQ(model->GetValue(0, 3499), base::Value(11999));
+  EXPECT_EQ(model->GetValue(0, 3500), base::Value(1500));
+  model->RemoveRows(1000, 3000);
+  ASSERT_EQ(model->GetRowCount(), 2000u);
+  for (uint32_t i = 0; i < 2000; ++i) {
+    int expected = static_cast<int>(i < 1000 ? i : i + 1000);
+    ASSERT_EQ(model->GetValue(0, i), base::Value(expected));
+  }
+  model->InsertRows(2001, make_rows(0, 1));
+  EXPECT_EQ(model->GetRowCount(), 2000u);
+  model->InsertRows(2000, make_rows(-1, 0));
+  EXPECT_EQ(model->GetValue(0, 2000), base::Value(-1));
+}
+
+TEST_F(TableTest, SimpleTableModelSlidingWindow) {
+  constexpr int kRows = 1000000;
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  std::vector<nu::SimpleTableModel::Row> rows;
+  rows.reserve(kRows);
+  for (int i = 0; i < kRows; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(i);
+    rows.push_back(std::move(row));
+  }
+  model->AddRows(std::move(rows));
+  // New rows come at the top and old rows are trimmed from the bottom.
+  for (int i = 1; i <= 10000; ++i) {
+    std::vector<nu::SimpleTableModel::Row> top(1);
+    top[0].emplace_back(-i);
+    model->InsertRows(0, std::move(top));
+    model->RemoveRows(kRows, 1);
+  }
+  ASSERT_EQ(model->GetRowCount(), static_cast<uint32_t>(kRows));
+  EXPECT_EQ(model->GetValue(0, 0), base::Value(-10000));
+  EXPECT_EQ(model->GetValue(0, 10000), base::Value(0));
+  EXPECT_EQ(model->GetValue(0, kRows - 1), base::Value(kRows - 10001));
+}
+
+TEST_F(TableTest, GetValueRef) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(1);
+  nu::SimpleTableModel::Row row;
+  row.emplace_back("text");
+  model->AddRow(std::move(row));
+  const base::Value* ref = model->GetValueRef(0, 0);
+  ASSERT_NE(ref, nullptr);
+  EXPECT_EQ(*ref, base::Value("text"));
+  EXPECT_EQ(model->GetValueRef(0, 0), ref);
+  EXPECT_EQ(model->GetValueRef(1, 0), nullptr);
+  EXPECT_EQ(model->GetValueRef(0, 1), nullptr);
+  scoped_refptr<nu::TableModel> custom = new TestTableModel;
+  EXPECT_EQ(custom->GetValueRef(0, 0), nullptr);
+}
+
+TEST_F(TableTest, ColumnarTableModel) {
+  using ColumnType = nu::ColumnarTableModel::ColumnType;
+  scoped_refptr<nu::ColumnarTableModel> model = new nu::ColumnarTableModel(
+      {ColumnType::Int64, ColumnType::Double, ColumnType::Bool,
+       ColumnType::String});
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  const int64_t ints[] = {1, 5000000000};
+  const double doubles[] = {0.5, 1.5};
+  const uint8_t bools[] = {1, 0};
+  const char chars[] = "firstsecond";
+  const uint32_t offsets[] = {0, 5, 11};
+  model->AppendInt64s(0, ints, 2);
+  model->AppendDoubles(1, doubles, 2);
+  model->AppendBools(2, bools, 2);
+  // Rows are only added after all columns are filled.
+  EXPECT_EQ(model->GetRowCount(), 0u);
+  model->AppendPackedStrings(3, chars, offsets, 2);
+  EXPECT_EQ(model->GetRowCount(), 2u);
+  EXPECT_EQ(model->GetInt64(0, 1), 5000000000);
+  EXPECT_EQ(model->GetString(3, 1), "second");
+  EXPECT_EQ(model->GetValue(0, 0), base::Value(1));
+  EXPECT_EQ(model->GetValue(0, 1), base::Value(5000000000.));
+  EXPECT_EQ(model->GetValue(1, 1), base::Value(1.5));
+  EXPECT_EQ(model->GetValue(2, 1), base::Value(false));
+  EXPECT_EQ(model->GetValue(3, 0), base::Value("first"));
+  // Type mismatch is ignored.
+  model->AppendDoubles(0, doubles, 2);
+  model->SetValue(1, 0, base::Value("text"));
+  EXPECT_EQ(model->GetValue(1, 0), base::Value(0.5));
+  model->SetValue(3, 0, base::Value("changed"));
+  EXPECT_EQ(model->GetString(3, 0), "changed");
+  EXPECT_EQ(model->GetString(3, 1), "second");
+  model->SetColumnFormatter(1, [](base::Value value) {
+    return base::Value(base::StringPrintf("%.2f", value.GetDouble()));
+  });
+  EXPECT_EQ(model->GetValue(1, 1), base::Value("1.50"));
+  model->AppendStrings(3, {"third"});
+  EXPECT_EQ(model->GetRowCount(), 2u);
+  model->Clear();
+  EXPECT_EQ(model->GetRowCount(), 0u);
+}
+
+TEST_F(TableTest, ColumnarTableModelEditStrings) {
+  scoped_refptr<nu::ColumnarTableModel> model = new nu::ColumnarTableModel(
+      {nu::ColumnarTableModel::ColumnType::String});
+  model->AppendStrings(0, {"a", "b", "c"});
+  // Keep editing with growing strings so the arena is compacted many times,
+  // other cells must survive the compaction.
+  for (int i = 0; i < 10000; ++i) {
+    model->SetValue(0, 1, base::Value(std::string(100 + i % 100, 'x')));
+    ASSERT_EQ(model->GetString(0, 1).size(), 100u + i % 100);
+  }
+  model->SetValue(0, 2, base::Value("short"));
+  EXPECT_EQ(model->GetString(0, 0), "a");
+  EXPECT_EQ(model->GetString(0, 2), "short");
+  model->SetValue(0, 2, base::Value("s"));
+  EXPECT_EQ(model->GetString(0, 2), "s");
+}
+
+TEST_F(TableTest, ProjectedTableModel) {
+  scoped_refptr<nu::SimpleTableModel> source = new nu::SimpleTableModel(2);
+  std::vector<nu::SimpleTableModel::Row> rows;
+  for (int i : {3, 1, 2, 1}) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(i);
+    row.emplace_back(static_cast<int>(rows.size()));
+    rows.push_back(std::move(row));
+  }
+  source->AddRows(std::move(rows));
+  scoped_refptr<nu::ProjectedTableModel> model =
+      new nu::ProjectedTableModel(source);
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  // Equal rows keep source order.
+  model->SetSortKeys({{0, true}});
+  EXPECT_EQ(model->GetRowCount(), 4u);
+  EXPECT_EQ(model->GetSourceRow(0), 1);
+  EXPECT_EQ(model->GetSourceRow(1), 3);
+  EXPECT_EQ(model->GetSourceRow(2), 2);
+  EXPECT_EQ(model->GetSourceRow(3), 0);
+  EXPECT_EQ(model->GetProjectedRow(0), 3);
+  model->SetSortKeys({{0, false}, {1, false}});
+  EXPECT_EQ(model->GetValue(1, 2), base::Value(3));
+  // Filter applies to source changes.
+  model->SetFilter([](nu::TableModel* source, uint32_t row) {
+    return source->GetValue(0, row).GetInt() > 1;
+  });
+  EXPECT_EQ(model->GetRowCount(), 2u);
+  EXPECT_EQ(model->GetProjectedRow(1), -1);
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(5);
+  row.emplace_back(4);
+  source->AddRow(std::move(row));
+  EXPECT_EQ(model->GetRowCount(), 3u);
+  EXPECT_EQ(model->GetSourceRow(0), 4);
+  source->SetValue(0, 2, base::Value(0));
+  EXPECT_EQ(model->GetRowCount(), 2u);
+  model->SetValue(0, 1, base::Value(9));
+  EXPECT_EQ(model->GetSourceRow(0), 0);
+  source->RemoveRowAt(0);
+  EXPECT_EQ(model->GetRowCount(), 1u);
+  EXPECT_EQ(model->GetSourceRow(0), 3);
+  EXPECT_EQ(model->GetSourceRow(1), -1);
+}
+
+TEST_F(TableTest, ProjectedTableModelProjectedRows) {
+  scoped_refptr<nu::SimpleTableModel> source = new nu::SimpleTableModel(1);
+  for (int i = 0; i < 100; ++i) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back((i * 37) % 100);
+    source->AddRow(std::move(row));
+  }
+  scoped_refptr<nu::ProjectedTableModel> model =
+      new nu::ProjectedTableModel(source);
+  model->SetSortKeys({{0, true}});
+  model->SetFilter([](nu::TableModel* source, uint32_t row) {
+    return source->GetValue(0, row).GetInt() % 3 != 0;
+  });
+  auto verify = [&]() {
+    for (uint32_t i = 0; i < model->GetRowCount(); ++i)
+      ASSERT_EQ(model->GetProjectedRow(model->GetSourceRow(i)),
+                static_cast<int>(i));
+    for (uint32_t row = 0; row < source->GetRowCount(); ++row) {
+      if (source->GetValue(0, row).GetInt() % 3 == 0)
+        ASSERT_EQ(model->GetProjectedRow(row), -1);
+    }
+  };
+  verify();
+  // Move rows forward, backward, in and out of the filter.
+  for (int i = 0; i < 200; ++i) {
+    source->SetValue(0, (i * 13) % 100, base::Value((i * 59) % 100));
+    verify();
+  }
+  source->RemoveRowAt(10);
+  verify();
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(50);
+  source->AddRow(std::move(row));
+  verify();
+}
+
+TEST_F(TableTest, ProjectedTableModelSortMillionRows) {
+  constexpr size_t kRows = 1000000;
+  scoped_refptr<nu::ColumnarTableModel> source = new nu::ColumnarTableModel(
+      {nu::ColumnarTableModel::ColumnType::Double});
+  std::vector<double> data(kRows);
+  for (size_t i = 0; i < kRows; ++i)
+    data[i] = static_cast<double>((i * 7919) % 1000);
+  source->AppendDoubles(0, data.data(), data.size());
+  scoped_refptr<nu::ProjectedTableModel> model =
+      new nu::ProjectedTableModel(source);
+  model->SetSortKeys({{0, true}});
+  ASSERT_EQ(model->GetRowCount(), kRows);
+  for (uint32_t i = 1; i < kRows; ++i) {
+    int a = model->GetSourceRow(i - 1);
+    int b = model->GetSourceRow(i);
+    ASSERT_TRUE(data[a] < data[b] || (data[a] == data[b] && a < b));
+  }
+}
+
+TEST_F(TableTest, AbstractTableModelGetRows) {
+  scoped_refptr<nu::AbstractTableModel> model = new nu::AbstractTableModel;
+  int get_rows_count = 0;
+  int offset = 0;
+  model->get_row_count = [](nu::AbstractTableModel*) { return 1000u; };
+  model->get_rows = [&](nu::AbstractTableModel*,
+                        uint32_t start, uint32_t count) {
+    ++get_rows_count;
+    base::Value::List rows;
+    for (uint32_t i = start; i < std::min(start + count, 1000u); ++i) {
+      base::Value::List row;
+      row.Append(static_cast<int>(i) + offset);
+      row.Append(static_cast<int>(i) * 2);
+      rows.Append(std::move(row));
+    }
+    return base::Value(std::move(rows));
+  };
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  get_rows_count = 0;
+  for (uint32_t i = 0; i < 100; ++i) {
+    EXPECT_EQ(model->GetValue(0, i), base::Value(static_cast<int>(i)));
+    EXPECT_EQ(model->GetValue(1, i), base::Value(static_cast<int>(i) * 2));
+  }
+  EXPECT_LE(get_rows_count, 2);
+  EXPECT_EQ(model->GetValue(0, 999), base::Value(999));
+  EXPECT_EQ(model->GetValue(2, 0), base::Value());
+  // Notifications drop the cached rows.
+  offset = 1;
+  get_rows_count = 0;
+  model->NotifyValueChange(0, 10);
+  EXPECT_EQ(model->GetValue(0, 10), base::Value(11));
+  EXPECT_EQ(get_rows_count, 1);
+  model->GetValue(0, 999);
+  EXPECT_EQ(get_rows_count, 1);
+  model->NotifyReset();
+  EXPECT_EQ(model->GetValue(0, 999), base::Value(1000));
+  EXPECT_EQ(get_rows_count, 2);
+}
+
+TEST_F(TableTest, AsyncTableModel) {
+  scoped_refptr<nu::AsyncTableModel> model = new nu::AsyncTableModel;
+  std::vector<std::pair<uint32_t, uint32_t>> requests;
+  std::vector<uint32_t> cancelled;
+  model->request_rows = [&](nu::AsyncTableModel*,
+                            uint32_t id, uint32_t start, uint32_t count) {
+    requests.emplace_back(id, start);
+  };
+  model->cancel_request = [&](nu::AsyncTableModel*, uint32_t id) {
+    cancelled.push_back(id);
+  };
+  model->SetPlaceholder(base::Value("..."));
+  model->SetRowCount(100000);
+  EXPECT_EQ(model->GetRowCount(), 100000u);
+  // Requests are sent in batch after reading.
+  EXPECT_EQ(model->GetValue(0, 1), base::Value("..."));
+  EXPECT_EQ(model->GetValue(0, 2), base::Value("..."));
+  EXPECT_TRUE(requests.empty());
+  nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(requests.size(), 1u);
+  EXPECT_EQ(requests[0].second, 0u);
+  base::Value::List rows;
+  for (int i = 0; i < 64; ++i) {
+    base::Value::List row;
+    row.Append(i);
+    rows.Append(std::move(row));
+  }
+  model->FulfillRequest(requests[0].first, base::Value(std::move(rows)));
+  EXPECT_TRUE(model->IsRowLoaded(2));
+  EXPECT_EQ(model->GetValue(0, 2), base::Value(2));
+  // Requests of rows scrolled out of view are cancelled.
+  requests.clear();
+  for (uint32_t row = 1000; row < 3000; row += 100)
+    model->GetValue(0, row);
+  nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(requests.size(), 8u);
+  EXPECT_TRUE(cancelled.empty());
+  for (uint32_t row = 50000; row < 50800; row += 100)
+    model->GetValue(0, row);
+  nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(cancelled.size(), 8u);
+  EXPECT_EQ(requests.size(), 16u);
+  // Cancelled requests are ignored.
+  model->FulfillRequest(cancelled[0], base::Value(base::Value::List()));
+  EXPECT_FALSE(model->IsRowLoaded(1000));
+}
+
+TEST_F(TableTest, AsyncTableModelShortBlock) {
+  scoped_refptr<nu::AsyncTableModel> model = new nu::AsyncTableModel;
+  std::vector<uint32_t> requests;
+  model->request_rows = [&](nu::AsyncTableModel*,
+                            uint32_t id, uint32_t start, uint32_t count) {
+    requests.push_back(id);
+  };
+  model->SetPlaceholder(base::Value("..."));
+  model->SetRowCount(100);
+  model->GetValue(0, 0);
+  nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  ASSERT_EQ(requests.size(), 1u);
+  base::Value::List rows;
+  for (int i = 0; i < 10; ++i) {
+    base::Value::List row;
+    row.Append(i);
+    rows.Append(std::move(row));
+  }
+  model->FulfillRequest(requests[0], base::Value(std::move(rows)));
+  EXPECT_EQ(model->GetValue(0, 9), base::Value(9));
+  // Rows missing from the block are not requested again.
+  EXPECT_TRUE(model->IsRowLoaded(20));
+  EXPECT_EQ(model->GetValue(0, 20), base::Value("..."));
+  nu::MessageLoop::PostTask([]() { nu::MessageLoop::Quit(); });
+  nu::MessageLoop::Run();
+  EXPECT_EQ(requests.size(), 1u);
+}
+
+TEST_F(TableTest, TreeTableModel) {
+  // Node N has children N * 10 + 1 to N * 10 + 3, up to 3 levels.
+  scoped_refptr<nu::TreeTableModel> model = new nu::TreeTableModel;
+  int enumerated = 0;
+  model->get_children = [&](nu::TreeTableModel*, uint32_t node) {
+    ++enumerated;
+    std::vector<uint32_t> children;
+    if (node < 100) {
+      for (uint32_t i = 1; i <= 3; ++i)
+        children.push_back(node * 10 + i);
+    }
+    return children;
+  };
+  model->has_children = [](nu::TreeTableModel*, uint32_t node) {
+    return node < 100;
+  };
+  model->get_value = [](nu::TreeTableModel*, uint32_t node, uint32_t column) {
+    return base::Value(std::to_string(node));
+  };
+  table_->AddColumn("A");
+  table_->SetModel(model);
+  EXPECT_EQ(model->GetRowCount(), 3u);
+  EXPECT_EQ(enumerated, 1);
+  EXPECT_EQ(model->GetNode(1), 2u);
+  EXPECT_EQ(model->GetValue(0, 1), base::Value("2"));
+  model->Expand(1);
+  EXPECT_EQ(enumerated, 2);
+  EXPECT_EQ(model->GetRowCount(), 6u);
+  EXPECT_EQ(model->GetNode(2), 21u);
+  EXPECT_EQ(model->GetDepth(2), 1u);
+  EXPECT_EQ(model->GetRow(3), 5);
+  model->Expand(2);
+  EXPECT_EQ(model->GetRowCount(), 9u);
+  EXPECT_FALSE(model->IsExpandable(3));
+  // Navigation between parents and children.
+  EXPECT_EQ(model->GetChildCount(-1), 3u);
+  EXPECT_EQ(model->GetChildCount(2), 3u);
+  EXPECT_EQ(model->GetChildRow(-1, 2), 8);
+  EXPECT_EQ(model->GetChildRow(1, 1), 6);
+  EXPECT_EQ(model->GetChildRow(1, 3), -1);
+  EXPECT_EQ(model->GetParentRow(4), 2);
+  EXPECT_EQ(model->GetParentRow(1), -1);
+  EXPECT_EQ(model->GetChildIndex(6), 1u);
+  EXPECT_EQ(model->GetNextSiblingRow(2), 6);
+  EXPECT_EQ(model->GetNextSiblingRow(7), -1);
+  // Collapsing drops all descendants.
+  model->Collapse(1);
+  EXPECT_EQ(model->GetRowCount(), 3u);
+  EXPECT_EQ(model->GetRow(211), -1);
+  model->Toggle(1);
+  EXPECT_FALSE(model->IsExpanded(2));
+  base::Value edited;
+  model->set_value = [&](nu::TreeTableModel*, uint32_t node, uint32_t column,
+                         base::Value value) {
+    edited = std::move(value);
+  };
+  model->SetValue(0, 1, base::Value("new"));
+  EXPECT_EQ(edited, base::Value("new"));
+  table_->SetSearchColumn(0);
+  EXPECT_EQ(table_->FindRows("22"), std::vector<int>({3}));
+}
+
+TEST_F(TableTest, TreeTableModelChildrenChanged) {
+  std::map<uint32_t, std::vector<uint32_t>> tree = {
+    {0, {1, 2}}, {1, {11, 12, 13}}, {12, {121, 122}}, {13, {131}},
+  };
+  scoped_refptr<nu::TreeTableModel> model = new nu::TreeTableModel;
+  int enumerated = 0;
+  int asked = 0;
+  model->get_children = [&](nu::TreeTableModel*, uint32_t node) {
+    ++enumerated;
+    return tree[node];
+  };
+  model->has_children = [&](nu::TreeTableModel*, uint32_t node) {
+    ++asked;
+    return !tree[node].empty();
+  };
+  table_->SetModel(model);
+  model->Expand(0);
+  model->Expand(2);
+  EXPECT_EQ(model->GetRowCount(), 7u);
+  EXPECT_EQ(model->GetRow(122), 4);
+  // The has_children delegate is only called once for each collapsed row.
+  EXPECT_TRUE(model->IsExpandable(5));
+  EXPECT_TRUE(model->IsExpandable(5));
+  EXPECT_FALSE(model->IsExpandable(3));
+  EXPECT_EQ(asked, 2);
+  model->NotifyNodeChanged(13);
+  EXPECT_TRUE(model->IsExpandable(5));
+  EXPECT_EQ(asked, 3);
+  // Only the direct children are enumerated again, and expanded children
+  // that still exist keep their rows.
+  tree[1] = {14, 12};
+  enumerated = 0;
+  model->NotifyChildrenChanged(1);
+  EXPECT_EQ(enumerated, 1);
+  EXPECT_EQ(model->GetRowCount(), 6u);
+  EXPECT_EQ(model->GetRow(11), -1);
+  EXPECT_EQ(model->GetRow(14), 1);
+  EXPECT_EQ(model->GetRow(12), 2);
+  EXPECT_TRUE(model->IsExpanded(2));
+  EXPECT_EQ(model->GetRow(122), 4);
+  EXPECT_EQ(model->GetDepth(4), 2u);
+  EXPECT_EQ(model->GetRow(2), 5);
+}
+
+TEST_F(TableTest, FindRows) {
+  scoped_refptr<nu::SimpleTableModel> model = new nu::SimpleTableModel(2);
+  for (const char* name : {"banana", "Apple", "cherry", "apricot"}) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(0);
+    row.emplace_back(name);
+    model->AddRow(std::move(row));
+  }
+  table_->SetModel(model);
+  EXPECT_EQ(table_->FindRows("a"), std::vector<int>());
+  table_->SetSearchColumn(1);
+  EXPECT_EQ(table_->GetSearchColumn(), 1);
+  EXPECT_EQ(table_->FindRows("a"), std::vector<int>({1, 3}));
+  EXPECT_EQ(table_->FindRows("AP"), std::vector<int>({1, 3}));
+  EXPECT_EQ(table_->FindRows("apr"), std::vector<int>({3}));
+  EXPECT_EQ(table_->FindRows("x"), std::vector<int>());
+  // The index follows changes of model.
+  nu::SimpleTableModel::Row row;
+  row.emplace_back(0);
+  row.emplace_back("avocado");
+  std::vector<nu::SimpleTableModel::Row> rows;
+  rows.push_back(std::move(row));
+  model->InsertRows(0, std::move(rows));
+  EXPECT_EQ(table_->FindRows("a"), std::vector<int>({0, 2, 4}));
+  model->RemoveRowAt(2);
+  EXPECT_EQ(table_->FindRows("a"), std::vector<int>({0, 3}));
+  model->SetValue(1, 1, base::Value("acorn"));
+  EXPECT_EQ(table_->FindRows("a"), std::vector<int>({0, 1, 3}));
+  model->SetValue(0, 2, base::Value("apple"));
+  EXPECT_EQ(table_->FindRows("ac"), std::vector<int>({1}));
+  // Appended rows are merged into the index on next search.
+  for (const char* name : {"acai", "banana", "acerola"}) {
+    nu::SimpleTableModel::Row row;
+    row.emplace_back(0);
+    row.emplace_back(name);
+    model->AddRow(std::move(row));
+  }
+  model->SetValue(1, 6, base::Value("achene"));
+  model->RemoveRowAt(5);
+  EXPECT_EQ(table_->FindRows("ac"), std::vector<int>({1, 4, 5}));
+  table_->SetSearchColumn(-1);
+  EXPECT_EQ(table_->FindRows("a"), std::vector<int>());
+}
+
+#if defined(OS_LINUX)
+TEST_F(TableTest, CellRasterCache) {
+  // Each 10x10 surface takes 400 bytes.
+  nu::CellRasterCache cache(1000);
+  auto put = [&cache](int row) {
+    cairo_surface_t* surface =
+        cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 10, 10);
+    cache.Put(row, 10, 10, 1, surface);
+    cairo_surface_destroy(surface);
+  };
+  put(0);
+  put(1);
+  EXPECT_EQ(cache.count(), 2u);
+  EXPECT_EQ(cache.size(), 800u);
+  EXPECT_NE(cache.Get(0, 10, 10, 1), nullptr);
+  EXPECT_EQ(cache.Get(0, 10, 10, 2), nullptr);
+  EXPECT_EQ(cache.Get(0, 20, 10, 1), nullptr);
+  // Row 1 is the least recently used one.
+  put(2);
+  EXPECT_EQ(cache.count(), 2u);
+  EXPECT_EQ(cache.Get(1, 10, 10, 1), nullptr);
+  EXPECT_NE(cache.Get(0, 10, 10, 1), nullptr);
+  EXPECT_NE(cache.Get(2, 10, 10, 1), nullptr);
+  cache.Invalidate(1, 3);
+  EXPECT_EQ(cache.count(), 1u);
+  EXPECT_EQ(cache.size(), 400u);
+  EXPECT_EQ(cache.Get(2, 10, 10, 1), nullptr);
+  // Surfaces larger than the budget are not cached.
+  cairo_surface_t* large =
+      cairo_image_surface_create(CAIRO_FORMAT_ARGB32, 100, 100);
+  cache.Put(5, 100, 100, 1, large);
+  cairo_surface_destroy(large);
+  EXPECT_EQ(cache.Get(5, 100, 100, 1), nullptr);
+  cache.Clear();
+  EXPECT_EQ(cache.count(), 0u);
+  EXPECT_EQ(cache.size(), 0u);
+}
+#endif
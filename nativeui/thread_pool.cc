@@ -0,0 +1,142 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/thread_pool.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "nativeui/message_loop.h"
+
+namespace nu {
+
+namespace {
+
+// The pool and index of current worker thread.
+thread_local ThreadPool* current_pool = nullptr;
+thread_local size_t current_worker = 0;
+
+}  // namespace
+
+ThreadPool::CancelToken::CancelToken() {}
+
+ThreadPool::CancelToken::~CancelToken() {}
+
+void ThreadPool::CancelToken::Cancel() {
+  cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool ThreadPool::CancelToken::IsCancelled() const {
+  return cancelled_.load(std::memory_order_relaxed);
+}
+
+ThreadPool::ThreadPool(size_t threads) : wake_up_(&sleep_lock_) {
+  if (threads == 0)
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  // Create all workers before starting threads, since they steal from each
+  // other.
+  for (size_t i = 0; i < threads; ++i)
+    workers_.push_back(std::make_unique<Worker>());
+  for (size_t i = 0; i < threads; ++i)
+    workers_[i]->thread = std::thread(&ThreadPool::WorkerMain, this, i);
+}
+
+ThreadPool::~ThreadPool() {
+  // Workers only quit after there is no pending task, so the queues are
+  // drained before the threads are joined.
+  {
+    base::AutoLock auto_lock(sleep_lock_);
+    quit_ = true;
+  }
+  wake_up_.Broadcast();
+  for (auto& worker : workers_)
+    worker->thread.join();
+}
+
+// static
+ThreadPool* ThreadPool::GetDefault() {
+  static ThreadPool* pool = new ThreadPool;
+  return pool;
+}
+
+void ThreadPool::PostTask(Task task,
+                          Priority priority,
+                          scoped_refptr<CancelToken> token) {
+  // Tasks posted by a worker go to its own queue.
+  size_t index = current_pool == this ?
+      current_worker :
+      next_worker_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+  // Count the task before pushing it, so the count never goes below the
+  // number of queued tasks.
+  {
+    base::AutoLock auto_lock(sleep_lock_);
+    pending_count_.fetch_add(1, std::memory_order_relaxed);
+  }
+  {
+    Worker* worker = workers_[index].get();
+    base::AutoLock auto_lock(worker->lock);
+    worker->queues[static_cast<size_t>(priority)].push_back(
+        {std::move(task), std::move(token)});
+  }
+  wake_up_.Signal();
+}
+
+void ThreadPool::PostTaskAndReply(Task task,
+                                  Task reply,
+                                  Priority priority,
+                                  scoped_refptr<CancelToken> token) {
+  // The token is checked by the task itself instead of the pool, so the
+  // |reply| is always moved back to the main thread and destroyed there, even
+  // when the task gets cancelled.
+  PostTask([task = std::move(task), reply = std::move(reply),
+            token]() mutable {
+    if (!token || !token->IsCancelled())
+      task();
+    if (!reply)
+      return;
+    MessageLoop::PostTask([reply = std::move(reply), token]() {
+      if (!token || !token->IsCancelled())
+        reply();
+    });
+  }, priority);
+}
+
+void ThreadPool::WorkerMain(size_t index) {
+  current_pool = this;
+  current_worker = index;
+  while (true) {
+    Item item;
+    if (TakeTask(index, &item)) {
+      if (!item.token || !item.token->IsCancelled())
+        item.task();
+      continue;
+    }
+    base::AutoLock auto_lock(sleep_lock_);
+    while (!quit_ && pending_count_.load(std::memory_order_relaxed) == 0)
+      wake_up_.Wait();
+    // Keep taking tasks when quitting, until the queues are drained.
+    if (quit_ && pending_count_.load(std::memory_order_relaxed) == 0)
+      return;
+  }
+}
+
+bool ThreadPool::TakeTask(size_t index, Item* item) {
+  for (size_t priority = 0; priority < kPriorityCount; ++priority) {
+    // Look at own queue first, and then the queues of others.
+    for (size_t i = 0; i < workers_.size(); ++i) {
+      Worker* worker = workers_[(index + i) % workers_.size()].get();
+      base::AutoLock auto_lock(worker->lock);
+      std::deque<Item>& queue = worker->queues[priority];
+      if (queue.empty())
+        continue;
+      *item = std::move(queue.front());
+      queue.pop_front();
+      pending_count_.fetch_sub(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace nu
@@ -0,0 +1,113 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_THREAD_POOL_H_
+#define NATIVEUI_THREAD_POOL_H_
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Runs tasks on background threads. Each thread has its own queues, and idle
+// threads steal tasks from busy ones. All methods are thread-safe.
+class NATIVEUI_EXPORT ThreadPool {
+ public:
+  enum class Priority {
+    High,
+    Normal,
+    Low,
+  };
+
+  // Function type for tasks.
+  using Task = std::function<void()>;
+
+  // Used for cancelling posted tasks that have not run yet.
+  class NATIVEUI_EXPORT CancelToken
+      : public base::RefCountedThreadSafe<CancelToken> {
+   public:
+    CancelToken();
+
+    void Cancel();
+    bool IsCancelled() const;
+
+   private:
+    friend class base::RefCountedThreadSafe<CancelToken>;
+
+    ~CancelToken();
+
+    std::atomic<bool> cancelled_{false};
+  };
+
+  // Create a pool with |threads| threads, 0 means the number of cores.
+  explicit ThreadPool(size_t threads = 0);
+  // Run all pending tasks and wait for them to finish, tasks with cancelled
+  // tokens are still skipped.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Return the pool shared by the process, which is never destroyed.
+  static ThreadPool* GetDefault();
+
+  // Run |task| on a background thread. The task is skipped if |token| gets
+  // cancelled before it runs.
+  void PostTask(Task task,
+                Priority priority = Priority::Normal,
+                scoped_refptr<CancelToken> token = nullptr);
+
+  // Run |task| on a background thread, and then run |reply| on the main
+  // thread. Both are skipped if |token| gets cancelled, and the |reply| is
+  // always destroyed on the main thread.
+  void PostTaskAndReply(Task task,
+                        Task reply,
+                        Priority priority = Priority::Normal,
+                        scoped_refptr<CancelToken> token = nullptr);
+
+  size_t GetThreadCount() const { return workers_.size(); }
+
+ private:
+  static constexpr size_t kPriorityCount = 3;
+
+  struct Item {
+    Task task;
+    scoped_refptr<CancelToken> token;
+  };
+
+  struct Worker {
+    base::Lock lock;
+    std::deque<Item> queues[kPriorityCount];
+    std::thread thread;
+  };
+
+  void WorkerMain(size_t index);
+
+  // Take a task from the queues of |index|, or steal one from other workers.
+  bool TakeTask(size_t index, Item* item);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+
+  // Used for distributing tasks posted from outside the pool.
+  std::atomic<size_t> next_worker_{0};
+
+  // Idle workers wait for posted tasks.
+  base::Lock sleep_lock_;
+  base::ConditionVariable wake_up_;
+  std::atomic<size_t> pending_count_{0};
+  bool quit_ = false;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_THREAD_POOL_H_
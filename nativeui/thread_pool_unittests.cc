@@ -0,0 +1,116 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+
+#include "nativeui/nativeui.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+class ThreadPoolTest : public testing::Test {
+ protected:
+  void SetUp() override {
+  }
+
+  nu::Lifetime lifetime_;
+  nu::State state_;
+};
+
+TEST_F(ThreadPoolTest, PostTask) {
+  std::atomic<int> count{0};
+  {
+    nu::ThreadPool pool(4);
+    EXPECT_EQ(pool.GetThreadCount(), 4u);
+    for (int i = 0; i < 1000; ++i) {
+      pool.PostTask([&pool, &count]() {
+        // Tasks posted by workers go to their own queues.
+        pool.PostTask([&count]() { ++count; });
+        ++count;
+      });
+    }
+    while (count < 2000)
+      std::this_thread::yield();
+  }
+  EXPECT_EQ(count, 2000);
+}
+
+TEST_F(ThreadPoolTest, Cancel) {
+  std::atomic<bool> ran{false};
+  std::atomic<bool> done{false};
+  nu::ThreadPool pool(1);
+  scoped_refptr<nu::ThreadPool::CancelToken> token =
+      new nu::ThreadPool::CancelToken;
+  token->Cancel();
+  pool.PostTask([&ran]() { ran = true; },
+                nu::ThreadPool::Priority::High, token);
+  // The cancelled task is posted first with higher priority, so it has been
+  // handled when the other one runs.
+  pool.PostTask([&done]() { done = true; }, nu::ThreadPool::Priority::Low);
+  while (!done)
+    std::this_thread::yield();
+  EXPECT_FALSE(ran);
+}
+
+TEST_F(ThreadPoolTest, CancelledReplyDestroyedOnMainThread) {
+  // Records the thread destroying the reply.
+  struct Watcher {
+    explicit Watcher(std::atomic<std::thread::id>* id) : id(id) {}
+    ~Watcher() { *id = std::this_thread::get_id(); }
+    std::atomic<std::thread::id>* id;
+  };
+  std::atomic<std::thread::id> destroy_thread{std::thread::id()};
+  bool ran = false;
+  scoped_refptr<nu::ThreadPool::CancelToken> token =
+      new nu::ThreadPool::CancelToken;
+  token->Cancel();
+  {
+    auto watcher = std::make_shared<Watcher>(&destroy_thread);
+    nu::ThreadPool::GetDefault()->PostTaskAndReply(
+        []() {},
+        [watcher, &ran]() { ran = true; },
+        nu::ThreadPool::Priority::Normal, token);
+  }
+  std::function<void()> check = [&]() {
+    if (destroy_thread.load() != std::thread::id())
+      nu::MessageLoop::Quit();
+    else
+      nu::MessageLoop::PostDelayedTask(1, check);
+  };
+  nu::MessageLoop::PostTask(check);
+  nu::MessageLoop::Run();
+  EXPECT_FALSE(ran);
+  EXPECT_EQ(destroy_thread.load(), std::this_thread::get_id());
+}
+
+TEST_F(ThreadPoolTest, PostBackgroundTask) {
+  std::thread::id main_thread = std::this_thread::get_id();
+  std::thread::id task_thread;
+  std::thread::id reply_thread;
+  nu::MessageLoop::PostBackgroundTask(
+      [&task_thread]() { task_thread = std::this_thread::get_id(); },
+      [&reply_thread]() {
+        reply_thread = std::this_thread::get_id();
+        nu::MessageLoop::Quit();
+      });
+  nu::MessageLoop::Run();
+  EXPECT_NE(task_thread, main_thread);
+  EXPECT_EQ(reply_thread, main_thread);
+}
+
+TEST_F(ThreadPoolTest, DestroyRunsPendingTasks) {
+  std::atomic<int> count{0};
+  {
+    nu::ThreadPool pool(2);
+    for (int i = 0; i < 100; ++i) {
+      pool.PostTask([&count]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        ++count;
+      }, nu::ThreadPool::Priority::Low);
+    }
+  }
+  EXPECT_EQ(count, 100);
+}
@@ -0,0 +1,302 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/tree_table_model.h"
+
+#include <utility>
+
+namespace nu {
+
+TreeTableModel::TreeTableModel(bool index_starts_from_0)
+    : index_starts_from_0_(index_starts_from_0) {}
+
+TreeTableModel::~TreeTableModel() {}
+
+void TreeTableModel::Expand(uint32_t row) {
+  EnsureLoaded();
+  if (row >= rows_.size() || rows_[row].expanded)
+    return;
+  std::vector<Row> children = GetChildren(row);
+  rows_[row].expanded = true;
+  rows_[row].has_children = children.empty() ? HasChildren::No
+                                             : HasChildren::Yes;
+  NotifyRangeChanged(row, 1);
+  InsertDescendants(row, std::move(children));
+}
+
+void TreeTableModel::Collapse(uint32_t row) {
+  EnsureLoaded();
+  if (row >= rows_.size() || !rows_[row].expanded)
+    return;
+  rows_[row].expanded = false;
+  RemoveDescendants(row);
+  NotifyRangeChanged(row, 1);
+}
+
+void TreeTableModel::Toggle(uint32_t row) {
+  if (IsExpanded(row))
+    Collapse(row);
+  else
+    Expand(row);
+}
+
+bool TreeTableModel::IsExpanded(uint32_t row) const {
+  EnsureLoaded();
+  return row < rows_.size() && rows_[row].expanded;
+}
+
+bool TreeTableModel::IsExpandable(uint32_t row) const {
+  EnsureLoaded();
+  if (row >= rows_.size())
+    return false;
+  if (rows_[row].expanded)
+    return row + 1 < rows_.size() && rows_[row + 1].depth > rows_[row].depth;
+  if (!has_children)
+    return true;
+  // The delegate is only asked once for each row, until the node changes.
+  Row& data = rows_[row];
+  if (data.has_children == HasChildren::Unknown) {
+    data.has_children =
+        has_children(const_cast<TreeTableModel*>(this), data.node) ?
+            HasChildren::Yes : HasChildren::No;
+  }
+  return data.has_children == HasChildren::Yes;
+}
+
+uint32_t TreeTableModel::GetDepth(uint32_t row) const {
+  EnsureLoaded();
+  return row < rows_.size() ? rows_[row].depth : 0;
+}
+
+TreeTableModel::NodeId TreeTableModel::GetNode(uint32_t row) const {
+  EnsureLoaded();
+  return row < rows_.size() ? rows_[row].node : kRootNode;
+}
+
+int TreeTableModel::GetRow(NodeId node) const {
+  EnsureLoaded();
+  auto it = row_of_node_.find(node);
+  if (it == row_of_node_.end())
+    return -1;
+  return static_cast<int>(it->second);
+}
+
+int TreeTableModel::GetParentRow(uint32_t row) const {
+  EnsureLoaded();
+  return row < rows_.size() ? rows_[row].parent : -1;
+}
+
+uint32_t TreeTableModel::GetChildCount(int row) const {
+  EnsureLoaded();
+  if (row < 0)
+    return top_level_count_;
+  return static_cast<size_t>(row) < rows_.size() ? rows_[row].children : 0;
+}
+
+int TreeTableModel::GetChildRow(int row, uint32_t index) const {
+  if (index >= GetChildCount(row))
+    return -1;
+  size_t start = row < 0 ? 0 : row + 1;
+  size_t end = row < 0 ? rows_.size() : GetSubtreeEnd(row);
+  uint32_t depth = row < 0 ? 0 : rows_[row].depth + 1;
+  // Children are ordered by their indices, so the child can be found with a
+  // binary search over the ancestors of rows at its depth.
+  while (start < end) {
+    size_t child = start + (end - start) / 2;
+    while (rows_[child].depth > depth)
+      child = rows_[child].parent;
+    if (rows_[child].index < index)
+      start = GetSubtreeEnd(child);
+    else if (rows_[child].index > index)
+      end = child;
+    else
+      return static_cast<int>(child);
+  }
+  return -1;
+}
+
+uint32_t TreeTableModel::GetChildIndex(uint32_t row) const {
+  EnsureLoaded();
+  return row < rows_.size() ? rows_[row].index : 0;
+}
+
+int TreeTableModel::GetNextSiblingRow(uint32_t row) const {
+  EnsureLoaded();
+  if (row >= rows_.size())
+    return -1;
+  size_t next = GetSubtreeEnd(row);
+  if (next >= rows_.size() || rows_[next].parent != rows_[row].parent)
+    return -1;
+  return static_cast<int>(next);
+}
+
+void TreeTableModel::SetTreeColumn(int column) {
+  tree_column_ = column;
+  NotifyReset();
+}
+
+void TreeTableModel::NotifyNodeChanged(NodeId node) {
+  int row = GetRow(node);
+  if (row < 0)
+    return;
+  rows_[row].has_children = HasChildren::Unknown;
+  NotifyRangeChanged(row, 1);
+}
+
+void TreeTableModel::NotifyChildrenChanged(NodeId node) {
+  if (node == kRootNode) {
+    Reload();
+    return;
+  }
+  int row = GetRow(node);
+  if (row < 0)
+    return;
+  rows_[row].has_children = HasChildren::Unknown;
+  if (!rows_[row].expanded) {
+    NotifyRangeChanged(row, 1);
+    return;
+  }
+  // Only the children are enumerated again, children that still exist keep
+  // the rows of their descendants.
+  std::vector<Row> rows;
+  for (Row& child : GetChildren(row)) {
+    int old_row = GetRow(child.node);
+    if (old_row <= row || rows_[old_row].parent != row) {
+      rows.push_back(child);
+      continue;
+    }
+    // Rows will be placed after |row|, with old descendants removed.
+    int offset = row + 1 + static_cast<int>(rows.size()) - old_row;
+    size_t end = GetSubtreeEnd(old_row);
+    for (size_t i = old_row; i < end; ++i) {
+      rows.push_back(rows_[i]);
+      if (i != static_cast<size_t>(old_row))
+        rows.back().parent += offset;
+      else
+        rows.back().index = child.index;
+    }
+  }
+  rows_[row].has_children = rows.empty() ? HasChildren::No : HasChildren::Yes;
+  RemoveDescendants(row);
+  InsertDescendants(row, std::move(rows));
+  NotifyRangeChanged(row, 1);
+}
+
+void TreeTableModel::Reload() {
+  rows_ = GetChildren(-1);
+  top_level_count_ = static_cast<uint32_t>(rows_.size());
+  loaded_ = static_cast<bool>(get_children);
+  RebuildRowMap();
+  NotifyReset();
+}
+
+uint32_t TreeTableModel::GetRowCount() const {
+  EnsureLoaded();
+  return static_cast<uint32_t>(rows_.size());
+}
+
+base::Value TreeTableModel::GetValue(uint32_t column, uint32_t row) const {
+  EnsureLoaded();
+  if (row >= rows_.size() || !get_value)
+    return base::Value();
+  return get_value(const_cast<TreeTableModel*>(this), rows_[row].node,
+                   index_starts_from_0_ ? column : column + 1);
+}
+
+void TreeTableModel::SetValue(uint32_t column, uint32_t row,
+                              base::Value value) {
+  if (row >= rows_.size() || !set_value)
+    return;
+  set_value(this, rows_[row].node,
+            index_starts_from_0_ ? column : column + 1, std::move(value));
+}
+
+TreeTableModel* TreeTableModel::AsTreeTableModel() {
+  return this;
+}
+
+void TreeTableModel::EnsureLoaded() const {
+  if (loaded_ || !get_children)
+    return;
+  loaded_ = true;
+  rows_ = GetChildren(-1);
+  top_level_count_ = static_cast<uint32_t>(rows_.size());
+  RebuildRowMap();
+}
+
+size_t TreeTableModel::GetSubtreeEnd(size_t row) const {
+  return row + 1 + rows_[row].descendants;
+}
+
+std::vector<TreeTableModel::Row> TreeTableModel::GetChildren(
+    int parent) const {
+  std::vector<Row> rows;
+  if (!get_children)
+    return rows;
+  NodeId node = parent < 0 ? kRootNode : rows_[parent].node;
+  uint32_t depth = parent < 0 ? 0 : rows_[parent].depth + 1;
+  std::vector<NodeId> children =
+      get_children(const_cast<TreeTableModel*>(this), node);
+  rows.reserve(children.size());
+  for (size_t i = 0; i < children.size(); ++i) {
+    rows.push_back({children[i], depth, parent, static_cast<uint32_t>(i), 0, 0,
+                    false, HasChildren::Unknown});
+  }
+  return rows;
+}
+
+void TreeTableModel::RebuildRowMap() const {
+  row_of_node_.clear();
+  row_of_node_.reserve(rows_.size());
+  for (size_t i = 0; i < rows_.size(); ++i)
+    row_of_node_[rows_[i].node] = static_cast<uint32_t>(i);
+}
+
+void TreeTableModel::RemoveDescendants(uint32_t row) {
+  uint32_t count = rows_[row].descendants;
+  if (count == 0)
+    return;
+  size_t start = row + 1;
+  for (size_t i = start; i < start + count; ++i)
+    row_of_node_.erase(rows_[i].node);
+  rows_.erase(rows_.begin() + start, rows_.begin() + start + count);
+  // Only keep memory for the rows of expanded nodes.
+  if (rows_.capacity() > 4 * rows_.size())
+    rows_.shrink_to_fit();
+  // Following rows move up, and so do their parents if they are after |row|.
+  for (size_t i = start; i < rows_.size(); ++i) {
+    if (rows_[i].parent > static_cast<int>(row))
+      rows_[i].parent -= count;
+    row_of_node_[rows_[i].node] = static_cast<uint32_t>(i);
+  }
+  for (int i = row; i >= 0; i = rows_[i].parent)
+    rows_[i].descendants -= count;
+  rows_[row].children = 0;
+  NotifyRowsDeleted(start, count);
+}
+
+void TreeTableModel::InsertDescendants(uint32_t row, std::vector<Row> rows) {
+  uint32_t count = static_cast<uint32_t>(rows.size());
+  if (count == 0)
+    return;
+  size_t start = row + 1;
+  rows_.insert(rows_.begin() + start, rows.begin(), rows.end());
+  uint32_t children = 0;
+  for (size_t i = start; i < start + count; ++i) {
+    row_of_node_[rows_[i].node] = static_cast<uint32_t>(i);
+    if (rows_[i].parent == static_cast<int>(row))
+      ++children;
+  }
+  for (size_t i = start + count; i < rows_.size(); ++i) {
+    if (rows_[i].parent > static_cast<int>(row))
+      rows_[i].parent += count;
+    row_of_node_[rows_[i].node] = static_cast<uint32_t>(i);
+  }
+  for (int i = row; i >= 0; i = rows_[i].parent)
+    rows_[i].descendants += count;
+  rows_[row].children = children;
+  NotifyRowsInserted(start, count);
+}
+
+}  // namespace nu
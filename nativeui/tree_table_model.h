@@ -0,0 +1,128 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_TREE_TABLE_MODEL_H_
+#define NATIVEUI_TREE_TABLE_MODEL_H_
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "nativeui/table_model.h"
+
+namespace nu {
+
+// Show hierarchical data in Table, rows of expanded nodes are flattened into
+// the table and children are only enumerated when their parent is expanded.
+class NATIVEUI_EXPORT TreeTableModel : public TableModel {
+ public:
+  // Stable and unique handle of nodes provided by delegates, the root node
+  // is 0.
+  using NodeId = uint32_t;
+  static constexpr NodeId kRootNode = 0;
+
+  explicit TreeTableModel(bool index_starts_from_0 = true);
+
+  // Expand or collapse the node shown at |row|. Collapsing a node drops the
+  // rows of its descendants.
+  void Expand(uint32_t row);
+  void Collapse(uint32_t row);
+  void Toggle(uint32_t row);
+  bool IsExpanded(uint32_t row) const;
+  bool IsExpandable(uint32_t row) const;
+
+  // How deep the node of |row| is in the tree, top level nodes have 0 depth.
+  uint32_t GetDepth(uint32_t row) const;
+
+  // Translate between rows and nodes, -1 is returned for nodes not shown.
+  NodeId GetNode(uint32_t row) const;
+  int GetRow(NodeId node) const;
+
+  // Navigate the rows as a tree, -1 is used as the row of root node, and is
+  // returned when there is no such row. Only children of expanded nodes are
+  // counted.
+  int GetParentRow(uint32_t row) const;
+  uint32_t GetChildCount(int row) const;
+  int GetChildRow(int row, uint32_t index) const;
+  uint32_t GetChildIndex(uint32_t row) const;
+  int GetNextSiblingRow(uint32_t row) const;
+
+  // Show the expanders in |column| on platforms that support it, pass -1 to
+  // hide them.
+  void SetTreeColumn(int column);
+  int GetTreeColumn() const { return tree_column_; }
+
+  // Called when data changes.
+  void NotifyNodeChanged(NodeId node);
+  void NotifyChildrenChanged(NodeId node);
+
+  // Enumerate top level nodes again.
+  void Reload();
+
+  // TableModel:
+  uint32_t GetRowCount() const override;
+  base::Value GetValue(uint32_t column, uint32_t row) const override;
+  void SetValue(uint32_t column, uint32_t row, base::Value value) override;
+  TreeTableModel* AsTreeTableModel() override;
+
+  // Delegate methods.
+  std::function<std::vector<NodeId>(TreeTableModel*, NodeId)> get_children;
+  std::function<bool(TreeTableModel*, NodeId)> has_children;
+  std::function<base::Value(TreeTableModel*, NodeId, uint32_t)> get_value;
+  std::function<void(TreeTableModel*, NodeId, uint32_t, base::Value)> set_value;
+
+ protected:
+  ~TreeTableModel() override;
+
+ private:
+  // Cached result of the has_children delegate.
+  enum class HasChildren : uint8_t {
+    Unknown,
+    Yes,
+    No,
+  };
+
+  struct Row {
+    NodeId node;
+    uint32_t depth;
+    // The row of parent node, -1 for top level nodes.
+    int parent;
+    // Position among siblings.
+    uint32_t index;
+    // Number of rows of loaded children and descendants.
+    uint32_t children;
+    uint32_t descendants;
+    bool expanded;
+    HasChildren has_children;
+  };
+
+  // Load top level nodes if they have not been loaded.
+  void EnsureLoaded() const;
+
+  // Return the end of the descendants of |row|.
+  size_t GetSubtreeEnd(size_t row) const;
+
+  // Return the rows of children of the node at |parent|, -1 for root node.
+  std::vector<Row> GetChildren(int parent) const;
+
+  // Rebuild |row_of_node_| for all rows.
+  void RebuildRowMap() const;
+
+  // Remove the rows of descendants of |row|, or insert |rows| as them, and
+  // then notify tables. Rows after them and ancestors are updated.
+  void RemoveDescendants(uint32_t row);
+  void InsertDescendants(uint32_t row, std::vector<Row> rows);
+
+  bool index_starts_from_0_;
+  int tree_column_ = 0;
+
+  mutable bool loaded_ = false;
+  mutable std::vector<Row> rows_;
+  mutable uint32_t top_level_count_ = 0;
+  mutable std::unordered_map<NodeId, uint32_t> row_of_node_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_TREE_TABLE_MODEL_H_
@@ -0,0 +1,57 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/measure_cache.h"
+
+#include <cmath>
+
+namespace nu {
+
+namespace {
+
+// Yoga passes NaN for undefined sizes, which should be treated as equal.
+inline bool SizeEqual(float a, float b) {
+  return a == b || (std::isnan(a) && std::isnan(b));
+}
+
+inline bool KeyEqual(const MeasureCache::Key& k1, const MeasureCache::Key& k2) {
+  return k1.revision == k2.revision &&
+         k1.width_mode == k2.width_mode &&
+         k1.height_mode == k2.height_mode &&
+         SizeEqual(k1.width, k2.width) &&
+         SizeEqual(k1.height, k2.height);
+}
+
+}  // namespace
+
+MeasureCache::MeasureCache() {}
+
+MeasureCache::~MeasureCache() {}
+
+bool MeasureCache::Get(const Key& key, SizeF* result) {
+  for (size_t i = 0; i < size_; ++i) {
+    if (KeyEqual(entries_[i].key, key)) {
+      *result = entries_[i].result;
+      ++hits_;
+      return true;
+    }
+  }
+  ++misses_;
+  return false;
+}
+
+void MeasureCache::Put(const Key& key, const SizeF& result) {
+  // Replace the oldest entry when full.
+  entries_[next_] = {key, result};
+  next_ = (next_ + 1) % kMaxEntries;
+  if (size_ < kMaxEntries)
+    ++size_;
+}
+
+void MeasureCache::Clear() {
+  size_ = 0;
+  next_ = 0;
+}
+
+}  // namespace nu
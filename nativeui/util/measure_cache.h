@@ -0,0 +1,56 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_MEASURE_CACHE_H_
+#define NATIVEUI_UTIL_MEASURE_CACHE_H_
+
+#include <array>
+
+#include "nativeui/gfx/geometry/size_f.h"
+
+namespace nu {
+
+// Remembers recent results of a view's measure function, so yoga asking for
+// the same constraints repeatedly during one flex pass does not measure again.
+class MeasureCache {
+ public:
+  struct Key {
+    float width;
+    int width_mode;
+    float height;
+    int height_mode;
+    // Revision of the content being measured.
+    int revision;
+  };
+
+  MeasureCache();
+  ~MeasureCache();
+
+  bool Get(const Key& key, SizeF* result);
+  void Put(const Key& key, const SizeF& result);
+  void Clear();
+
+  int hits() const { return hits_; }
+  int misses() const { return misses_; }
+
+ private:
+  // Yoga keeps up to 16 results per node, but text usually settles in a few.
+  static constexpr size_t kMaxEntries = 8;
+
+  struct Entry {
+    Key key;
+    SizeF result;
+  };
+
+  std::array<Entry, kMaxEntries> entries_;
+  size_t size_ = 0;
+  size_t next_ = 0;
+
+  int hits_ = 0;
+  int misses_ = 0;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_MEASURE_CACHE_H_
@@ -0,0 +1,136 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#include "nativeui/util/timer_wheel.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace nu {
+
+TimerWheel::TimerWheel(uint64_t now) : current_(now) {}
+
+TimerWheel::~TimerWheel() {}
+
+TimerWheel::TimerId TimerWheel::Add(uint64_t expiry, Task task) {
+  while (next_id_ == 0 || locations_.count(next_id_))
+    ++next_id_;
+  TimerId id = next_id_++;
+  // Put the timer in the expired slot temporarily and then move it to the
+  // wheel, the list nodes are spliced without copying.
+  expired_.push_back({id, std::max(expiry, current_), std::move(task)});
+  Insert(&expired_, std::prev(expired_.end()));
+  return id;
+}
+
+bool TimerWheel::Cancel(TimerId id, Task* task) {
+  auto it = locations_.find(id);
+  if (it == locations_.end())
+    return false;
+  if (it->second.level >= 0)
+    --counts_[it->second.level];
+  if (task)
+    *task = std::move(it->second.it->task);
+  it->second.slot->erase(it->second.it);
+  locations_.erase(it);
+  return true;
+}
+
+void TimerWheel::Advance(uint64_t now) {
+  while (current_ <= now) {
+    // Move timers down from higher levels when reaching their ranges, higher
+    // levels first so they can be moved further down.
+    for (int level = kLevels - 1; level > 0; --level) {
+      if ((current_ & ((uint64_t(1) << (kSlotBits * level)) - 1)) == 0)
+        Cascade(level);
+    }
+    Slot& slot = wheels_[0][current_ & (kSlots - 1)];
+    for (auto it = slot.begin(); it != slot.end(); ++it) {
+      Location& location = locations_[it->id];
+      location.slot = &expired_;
+      location.level = -1;
+      --counts_[0];
+    }
+    expired_.splice(expired_.end(), slot);
+    ++current_;
+    // When lower levels are empty, nothing happens until the next tick that
+    // cascades the lowest non-empty level.
+    int level = 0;
+    while (level < kLevels && counts_[level] == 0)
+      ++level;
+    if (level == kLevels) {
+      current_ = std::max(current_, now + 1);
+    } else if (level > 0) {
+      uint64_t mask = (uint64_t(1) << (kSlotBits * level)) - 1;
+      current_ = std::min((current_ + mask) & ~mask, now + 1);
+    }
+  }
+}
+
+bool TimerWheel::PopExpired(Task* task) {
+  if (expired_.empty())
+    return false;
+  Timer& timer = expired_.front();
+  *task = std::move(timer.task);
+  locations_.erase(timer.id);
+  expired_.pop_front();
+  return true;
+}
+
+bool TimerWheel::GetNextTick(uint64_t* tick) const {
+  if (!expired_.empty()) {
+    *tick = current_;
+    return true;
+  }
+  bool found = false;
+  for (int level = 0; level < kLevels; ++level) {
+    // Slots are scanned in the order they are reached. The current slot of
+    // higher levels belongs to the next round after it has been cascaded,
+    // which happens when current tick is at the start of its range.
+    uint64_t position = current_ >> (kSlotBits * level);
+    uint64_t mask = (uint64_t(1) << (kSlotBits * level)) - 1;
+    uint64_t first = (current_ & mask) == 0 ? 0 : 1;
+    for (uint64_t i = first; i < first + kSlots; ++i) {
+      const Slot& slot = wheels_[level][(position + i) & (kSlots - 1)];
+      if (slot.empty())
+        continue;
+      // Timers in higher levels need to be moved down at the start of the
+      // slot's range, before they can expire.
+      uint64_t next = (position + i) << (kSlotBits * level);
+      if (!found || next < *tick)
+        *tick = next;
+      found = true;
+      break;
+    }
+  }
+  return found;
+}
+
+void TimerWheel::Insert(Slot* from, Slot::iterator it) {
+  uint64_t delta = it->expiry - current_;
+  int level = 0;
+  while (level < kLevels - 1 &&
+         delta >= (uint64_t(1) << (kSlotBits * (level + 1))))
+    ++level;
+  // Timers too far away are put at the end of the last level, and will be
+  // inserted again when the wheel reaches them.
+  uint64_t max_delta = (uint64_t(1) << (kSlotBits * kLevels)) - 1;
+  uint64_t expiry = current_ + std::min(delta, max_delta);
+  Slot* slot = &wheels_[level][(expiry >> (kSlotBits * level)) &
+                               (kSlots - 1)];
+  slot->splice(slot->end(), *from, it);
+  locations_[it->id] = {slot, it, level};
+  ++counts_[level];
+}
+
+void TimerWheel::Cascade(int level) {
+  Slot& slot = wheels_[level][(current_ >> (kSlotBits * level)) &
+                              (kSlots - 1)];
+  counts_[level] -= slot.size();
+  while (!slot.empty())
+    Insert(&slot, slot.begin());
+}
+
+}  // namespace nu
@@ -0,0 +1,98 @@
+// Copyright 2023 Cheng Zhao. All rights reserved.
+// Use of this source code is governed by the license that can be found in the
+// LICENSE file.
+
+#ifndef NATIVEUI_UTIL_TIMER_WHEEL_H_
+#define NATIVEUI_UTIL_TIMER_WHEEL_H_
+
+#include <stdint.h>
+
+#include <array>
+#include <functional>
+#include <list>
+#include <unordered_map>
+
+#include "nativeui/nativeui_export.h"
+
+namespace nu {
+
+// Hierarchical timer wheel, timers are put into slots by their expiry ticks
+// so adding and cancelling a timer are O(1). Timers in higher levels are
+// moved down when the wheel reaches their slots.
+//
+// The wheel does not read clock by itself, and is not thread-safe.
+class NATIVEUI_EXPORT TimerWheel {
+ public:
+  using Task = std::function<void()>;
+  using TimerId = unsigned int;
+
+  explicit TimerWheel(uint64_t now);
+  ~TimerWheel();
+
+  TimerWheel(const TimerWheel&) = delete;
+  TimerWheel& operator=(const TimerWheel&) = delete;
+
+  // Add a timer that expires at tick |expiry|, expired ticks are treated as
+  // the current one.
+  TimerId Add(uint64_t expiry, Task task);
+
+  // Remove the timer, return false if it does not exist or has run. When
+  // |task| is not null the task of timer is moved into it, so the caller can
+  // choose when to destroy it.
+  bool Cancel(TimerId id, Task* task = nullptr);
+
+  // Move the wheel to |now|, timers expired on the way are queued to run.
+  void Advance(uint64_t now);
+
+  // Take the task of next queued timer, return false if there is none.
+  bool PopExpired(Task* task);
+
+  // Return the tick when the wheel should be advanced next, which is no
+  // later than the expiry of next timer. Return false if there is no timer.
+  bool GetNextTick(uint64_t* tick) const;
+
+  size_t size() const { return locations_.size(); }
+
+ private:
+  static constexpr int kLevels = 4;
+  static constexpr int kSlotBits = 6;
+  static constexpr uint64_t kSlots = 1 << kSlotBits;
+
+  struct Timer {
+    TimerId id;
+    uint64_t expiry;
+    Task task;
+  };
+
+  using Slot = std::list<Timer>;
+
+  struct Location {
+    Slot* slot;
+    Slot::iterator it;
+    // -1 for expired timers.
+    int level;
+  };
+
+  // Put a timer from |from| into the wheel relative to current tick.
+  void Insert(Slot* from, Slot::iterator it);
+
+  // Move timers of the slot at |level| down to lower levels.
+  void Cascade(int level);
+
+  // The next tick to process.
+  uint64_t current_;
+
+  TimerId next_id_ = 1;
+
+  std::array<std::array<Slot, kSlots>, kLevels> wheels_;
+  // Number of timers in each level, used for skipping empty ticks.
+  std::array<size_t, kLevels> counts_ = {};
+  // Expired timers waiting to run.
+  Slot expired_;
+
+  std::unordered_map<TimerId, Location> locations_;
+};
+
+}  // namespace nu
+
+#endif  // NATIVEUI_UTIL_TIMER_WHEEL_H_
@@ -273,10 +273,24 @@ T* Find(T (&setters)[n], const std::string& name) {
   return &(*iter);
 }
 
-// Set style for int properties.
-bool SetIntStyle(YGNodeRef node,
-                 const std::string& name,
-                 const std::string& value) {
+// Return the index of the element found in array.
+template<typename T, size_t n>
+size_t IndexOf(T (&setters)[n], T* element) {
+  return static_cast<size_t>(element - std::begin(setters));
+}
+
+// Call the setter of edge properties.
+template<typename T, size_t n>
+void ApplyEdgeSetter(T (&setters)[n], YGNodeRef node, size_t index,
+                     float value) {
+  const T& tup = setters[index];
+  std::get<2>(tup)(node, std::get<1>(tup), value);
+}
+
+// Parse style for int properties.
+bool ParseIntStyle(const std::string& name,
+                   const std::string& value,
+                   YogaProperty* out) {
   auto* tup = Find(int_setters, name);
   if (!tup)
     return false;
@@ -285,72 +299,83 @@ bool SetIntStyle(YGNodeRef node,
     LOG(WARNING) << "Invalid value " << value << " for property " << name;
     return false;
   }
-  std::get<2>(*tup)(node, converted);
+  out->type = YogaProperty::Type::Int;
+  out->index = IndexOf(int_setters, tup);
+  out->int_value = converted;
   return true;
 }
 
-// Set style for float properties.
-bool SetFloatStyle(YGNodeRef node, const std::string& name, float value) {
+// Parse style for float properties.
+bool ParseFloatStyle(const std::string& name, float value, YogaProperty* out) {
   auto* tup = Find(float_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node, value);
+  out->type = YogaProperty::Type::Float;
+  out->index = IndexOf(float_setters, tup);
+  out->float_value = value;
   return true;
 }
 
-// Set "auto" property for styles.
-bool SetAutoStyle(YGNodeRef node, const std::string& name) {
+// Parse "auto" property for styles.
+bool ParseAutoStyle(const std::string& name, YogaProperty* out) {
   auto* tup = Find(auto_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node);
+  out->type = YogaProperty::Type::Auto;
+  out->index = IndexOf(auto_setters, tup);
   return true;
 }
 
 // Dispatch to float for auto depending on the value.
-bool SetUnitStyle(YGNodeRef node,
-                  const std::string& name,
-                  const std::string& value) {
+bool ParseUnitStyle(const std::string& name,
+                    const std::string& value,
+                    YogaProperty* out) {
   if (value == "auto")
-    return SetAutoStyle(node, name);
+    return ParseAutoStyle(name, out);
   else
-    return SetFloatStyle(node, name, PixelValue(value));
+    return ParseFloatStyle(name, PixelValue(value), out);
 }
 
-// Set style for percent properties.
-bool SetPercentStyle(YGNodeRef node,
-                     const std::string& name,
-                     const std::string& value) {
+// Parse style for percent properties.
+bool ParsePercentStyle(const std::string& name,
+                       const std::string& value,
+                       YogaProperty* out) {
   auto* tup = Find(percent_setters, name);
   if (!tup)
     return false;
-  std::get<1>(*tup)(node, PercentValue(value));
+  out->type = YogaProperty::Type::Percent;
+  out->index = IndexOf(percent_setters, tup);
+  out->float_value = PercentValue(value);
   return true;
 }
 
-// Set style for edge properties.
-bool SetEdgeStyle(YGNodeRef node, const std::string& name, float value) {
+// Parse style for edge properties.
+bool ParseEdgeStyle(const std::string& name, float value, YogaProperty* out) {
   auto* tup = Find(edge_setters, name);
   if (!tup)
     return false;
-  std::get<2>(*tup)(node, std::get<1>(*tup), value);
+  out->type = YogaProperty::Type::Edge;
+  out->index = IndexOf(edge_setters, tup);
+  out->float_value = value;
   return true;
 }
 
-bool SetEdgeStyle(YGNodeRef node,
-                  const std::string& name,
-                  const std::string& value) {
-  return SetEdgeStyle(node, name, PixelValue(value));
+bool ParseEdgeStyle(const std::string& name,
+                    const std::string& value,
+                    YogaProperty* out) {
+  return ParseEdgeStyle(name, PixelValue(value), out);
 }
 
-// Set style for edge percent properties.
-bool SetEdgePercentStyle(YGNodeRef node,
-                         const std::string& name,
-                         const std::string& value) {
+// Parse style for edge percent properties.
+bool ParseEdgePercentStyle(const std::string& name,
+                           const std::string& value,
+                           YogaProperty* out) {
   auto* tup = Find(edge_percent_setters, name);
   if (!tup)
     return false;
-  std::get<2>(*tup)(node, std::get<1>(*tup), PercentValue(value));
+  out->type = YogaProperty::Type::EdgePercent;
+  out->index = IndexOf(edge_percent_setters, tup);
+  out->float_value = PercentValue(value);
   return true;
 }
 
@@ -363,14 +388,33 @@ bool IsPercentValue(const std::string& value) {
 
 }  // namespace
 
-void SetYogaProperty(YGNodeRef node, const std::string& name, float value) {
-  SetFloatStyle(node, name, value) ||
-  SetEdgeStyle(node, name, value);
+YogaConfig::YogaConfig() : config_(YGConfigNew()) {
 }
 
-void SetYogaProperty(YGNodeRef node,
-                     const std::string& name,
-                     const std::string& value) {
+YogaConfig::~YogaConfig() {
+  YGConfigFree(config_);
+}
+
+std::string ParseStyleName(const std::string& name) {
+  std::string parsed;
+  parsed.reserve(name.size());
+  for (char c : name) {
+    if (base::IsAsciiAlpha(c))
+      parsed.push_back(base::ToLowerASCII(c));
+  }
+  return parsed;
+}
+
+bool ParseYogaProperty(const std::string& name,
+                       float value,
+                       YogaProperty* out) {
+  return ParseFloatStyle(name, value, out) ||
+         ParseEdgeStyle(name, value, out);
+}
+
+bool ParseYogaProperty(const std::string& name,
+                       const std::string& value,
+                       YogaProperty* out) {
   DCHECK(IsSorted(int_setters) &&
          IsSorted(float_setters) &&
          IsSorted(auto_setters) &&
@@ -378,13 +422,51 @@ void SetYogaProperty(YGNodeRef node,
          IsSorted(edge_setters) &&
          IsSorted(edge_percent_setters)) << "Property setters must be sorted";
   if (IsPercentValue(value)) {
-    SetPercentStyle(node, name, value) ||
-    SetEdgePercentStyle(node, name, value);
+    return ParsePercentStyle(name, value, out) ||
+           ParseEdgePercentStyle(name, value, out);
   } else {
-    SetIntStyle(node, name, value) ||
-    SetUnitStyle(node, name, value) ||
-    SetEdgeStyle(node, name, value);
+    return ParseIntStyle(name, value, out) ||
+           ParseUnitStyle(name, value, out) ||
+           ParseEdgeStyle(name, value, out);
   }
 }
 
+void ApplyYogaProperty(YGNodeRef node, const YogaProperty& property) {
+  switch (property.type) {
+    case YogaProperty::Type::Int:
+      std::get<2>(int_setters[property.index])(node, property.int_value);
+      break;
+    case YogaProperty::Type::Float:
+      std::get<1>(float_setters[property.index])(node, property.float_value);
+      break;
+    case YogaProperty::Type::Percent:
+      std::get<1>(percent_setters[property.index])(node, property.float_value);
+      break;
+    case YogaProperty::Type::Auto:
+      std::get<1>(auto_setters[property.index])(node);
+      break;
+    case YogaProperty::Type::Edge:
+      ApplyEdgeSetter(edge_setters, node, property.index, property.float_value);
+      break;
+    case YogaProperty::Type::EdgePercent:
+      ApplyEdgeSetter(edge_percent_setters, node, property.index,
+                      property.float_value);
+      break;
+  }
+}
+
+void SetYogaProperty(YGNodeRef node, const std::string& name, float value) {
+  YogaProperty property;
+  if (ParseYogaProperty(name, value, &property))
+    ApplyYogaProperty(node, property);
+}
+
+void SetYogaProperty(YGNodeRef node,
+                     const std::string& name,
+                     const std::string& value) {
+  YogaProperty property;
+  if (ParseYogaProperty(name, value, &property))
+    ApplyYogaProperty(node, property);
+}
+
 }  // namespace nu
@@ -7,10 +7,58 @@
 
 #include <string>
 
+#include "base/memory/ref_counted.h"
+
 typedef struct YGNode *YGNodeRef;
+typedef struct YGConfig *YGConfigRef;
 
 namespace nu {
 
+// Ref-counted wrapper of YGConfigRef, so views of the same window can share
+// one config instead of each owning a copy.
+class YogaConfig : public base::RefCounted<YogaConfig> {
+ public:
+  YogaConfig();
+
+  YGConfigRef get() const { return config_; }
+
+ private:
+  friend class base::RefCounted<YogaConfig>;
+
+  ~YogaConfig();
+
+  YGConfigRef config_;
+};
+
+// A style property resolved to an entry of yoga setters, which can be applied
+// to nodes without parsing the name and value again.
+struct YogaProperty {
+  // Which setter table the |index| refers to.
+  enum class Type {
+    Int,
+    Float,
+    Percent,
+    Auto,
+    Edge,
+    EdgePercent,
+  };
+
+  Type type = Type::Float;
+  size_t index = 0;
+  int int_value = 0;
+  float float_value = 0;
+};
+
+// Convert case to lower and remove non-ASCII characters.
+std::string ParseStyleName(const std::string& name);
+
+// Resolve the property with parsed |key|, return false if it is invalid.
+bool ParseYogaProperty(const std::string& key, float value, YogaProperty* out);
+bool ParseYogaProperty(const std::string& key,
+                       const std::string& value,
+                       YogaProperty* out);
+void ApplyYogaProperty(YGNodeRef node, const YogaProperty& property);
+
 void SetYogaProperty(YGNodeRef node, const std::string& key, float value);
 void SetYogaProperty(YGNodeRef node,
                      const std::string& key,
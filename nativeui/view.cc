@@ -6,13 +6,15 @@
 
 #include <utility>
 
-#include "base/strings/string_util.h"
+#include "base/logging.h"
 #include "nativeui/container.h"
 #include "nativeui/cursor.h"
 #include "nativeui/gfx/font.h"
 #include "nativeui/state.h"
+#include "nativeui/style.h"
 #include "nativeui/util/yoga_util.h"
 #include "nativeui/window.h"
+#include "third_party/yoga/YGNode.h"
 #include "third_party/yoga/Yoga.h"
 
 #if defined(OS_WIN)
@@ -30,35 +32,18 @@
 
 namespace nu {
 
-namespace {
-
-// Convert case to lower and remove non-ASCII characters.
-std::string ParseName(const std::string& name) {
-  std::string parsed;
-  parsed.reserve(name.size());
-  for (char c : name) {
-    if (base::IsAsciiAlpha(c))
-      parsed.push_back(base::ToLowerASCII(c));
-  }
-  return parsed;
-}
-
-}  // namespace
-
-View::View() : view_(nullptr) {
+View::View()
+    : view_(nullptr), yoga_config_(State::GetCurrent()->yoga_config()) {
   // Create node with the default yoga config.
-  yoga_config_ = YGConfigNew();
-  YGConfigCopy(yoga_config_, State::GetCurrent()->yoga_config());
-  node_ = YGNodeNewWithConfig(yoga_config_);
+  node_ = YGNodeNewWithConfig(yoga_config_->get());
   YGNodeSetContext(node_, this);
 }
 
 View::~View() {
   PlatformDestroy();
 
-  // Free yoga config and node.
+  // Free yoga node, the config is released with the last view using it.
   YGNodeFree(node_);
-  YGConfigFree(yoga_config_);
 }
 
 void View::SetVisible(bool visible) {
@@ -75,6 +60,13 @@ void View::Layout() {
     static_cast<Container*>(GetParent())->Layout();
 }
 
+void View::LayoutImmediately() {
+  Layout();
+  Window* window = GetWindow();
+  if (window)
+    window->FlushLayout();
+}
+
 int View::DoDrag(std::vector<Clipboard::Data> data, int operations) {
   DragOptions options;
   return DoDragWithOptions(std::move(data), operations, options);
@@ -147,8 +139,21 @@ void View::UpdateDefaultStyle() {
   Layout();
 }
 
+void View::SetYogaConfig(scoped_refptr<YogaConfig> config) {
+  if (yoga_config_ == config)
+    return;
+  yoga_config_ = std::move(config);
+  node_->setConfig(yoga_config_->get());
+  // Children added before this view was attached still use the old config.
+  if (IsContainer()) {
+    auto* container = static_cast<Container*>(this);
+    for (int i = 0; i < container->ChildCount(); ++i)
+      container->ChildAt(i)->SetYogaConfig(yoga_config_);
+  }
+}
+
 void View::SetStyleProperty(const std::string& name, const std::string& value) {
-  std::string key(ParseName(name));
+  std::string key(ParseStyleName(name));
   if (key == "color")
     SetColor(Color(value));
   else if (key == "backgroundcolor")
@@ -158,7 +163,19 @@ void View::SetStyleProperty(const std::string& name, const std::string& value) {
 }
 
 void View::SetStyleProperty(const std::string& name, float value) {
-  SetYogaProperty(node_, ParseName(name), value);
+  SetYogaProperty(node_, ParseStyleName(name), value);
+}
+
+void View::SetStyle(Style* style) {
+  DCHECK(style);
+  if (!style)
+    return;
+  if (style->color())
+    SetColor(*style->color());
+  if (style->background_color())
+    SetBackgroundColor(*style->background_color());
+  style->ApplyTo(node_);
+  Layout();
 }
 
 std::string View::GetComputedLayout() const {
@@ -176,14 +193,13 @@ SizeF View::GetMinimumSize() const {
 
 void View::SetParent(View* parent) {
   if (parent)
-    YGConfigCopy(yoga_config_, parent->yoga_config_);
+    SetYogaConfig(parent->yoga_config_);
   parent_ = parent;
 }
 
 void View::BecomeContentView(Window* window) {
-  if (window) {
-    YGConfigCopy(yoga_config_, window->GetYogaConfig());
-  }
+  if (window)
+    SetYogaConfig(window->GetYogaConfig());
   parent_ = nullptr;
 }
 
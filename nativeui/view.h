@@ -18,7 +18,6 @@
 #include "nativeui/responder.h"
 
 typedef struct YGNode *YGNodeRef;
-typedef struct YGConfig *YGConfigRef;
 
 #if defined(OS_LINUX)
 typedef struct _GtkTooltip GtkTooltip;
@@ -26,10 +25,13 @@ typedef struct _GtkTooltip GtkTooltip;
 
 namespace nu {
 
+class Canvas;
 class Cursor;
 class Font;
 class Popover;
+class Style;
 class Window;
+class YogaConfig;
 
 // The base class for all kinds of views.
 class NATIVEUI_EXPORT View : public Responder {
@@ -52,6 +54,9 @@ class NATIVEUI_EXPORT View : public Responder {
   // Update layout.
   virtual void Layout();
 
+  // Update layout and apply the bounds now even if window defers layout.
+  void LayoutImmediately();
+
   // Mark the whole view as dirty.
   void SchedulePaint();
 
@@ -126,6 +131,9 @@ class NATIVEUI_EXPORT View : public Responder {
   void SetStyle() {
   }
 
+  // Apply a pre-parsed style and re-compute the layout.
+  void SetStyle(Style* style);
+
   // Return the string representation of yoga style.
   std::string GetComputedLayout() const;
 
@@ -137,6 +145,11 @@ class NATIVEUI_EXPORT View : public Responder {
   bool WantsLayer() const;
 #endif
 
+#if defined(OS_LINUX)
+  // Internal: Drop the cached bitmaps of the view and its ancestors.
+  void InvalidateRasterCache();
+#endif
+
   // Get parent.
   View* GetParent() const { return parent_; }
 
@@ -185,6 +198,9 @@ class NATIVEUI_EXPORT View : public Responder {
   // Update the default style.
   void UpdateDefaultStyle();
 
+  // Share the yoga |config| with this view and its children.
+  void SetYogaConfig(scoped_refptr<YogaConfig> config);
+
   // Called by subclasses to take the ownership of |view|.
   void TakeOverView(NativeView view);
 
@@ -213,8 +229,8 @@ class NATIVEUI_EXPORT View : public Responder {
   // The native implementation.
   NativeView view_;
 
-  // The config of its yoga node.
-  YGConfigRef yoga_config_;
+  // The config of its yoga node, shared with other views of the same window.
+  scoped_refptr<YogaConfig> yoga_config_;
 
   // The font used for the view.
   scoped_refptr<Font> font_;
@@ -4,6 +4,7 @@
 
 #include "nativeui/nativeui.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "third_party/yoga/Yoga.h"
 
 class ViewTest : public testing::Test {
  protected:
@@ -90,3 +91,31 @@ TEST_F(ViewTest, OnSizeChanged) {
   window->SetContentSize(nu::SizeF(100, 100));
   EXPECT_TRUE(changed);
 }
+
+TEST_F(ViewTest, SharedYogaConfig) {
+  // Creating views should not allocate any yoga config.
+  int count = YGConfigGetInstanceCount();
+  scoped_refptr<nu::Container> container(new nu::Container);
+  for (int i = 0; i < 1000; ++i)
+    container->AddChildView(new nu::Label);
+  EXPECT_EQ(YGConfigGetInstanceCount(), count);
+  // Only the window owns a new config, which is then shared by the children.
+  scoped_refptr<nu::Window> window(new nu::Window(nu::Window::Options()));
+  window->SetContentView(container.get());
+  EXPECT_EQ(YGConfigGetInstanceCount(), count + 1);
+  container->AddChildView(new nu::Label);
+  EXPECT_EQ(YGConfigGetInstanceCount(), count + 1);
+}
+
+TEST_F(ViewTest, SetStyleObject) {
+  scoped_refptr<nu::Style> style(new nu::Style({{"flex", "1"},
+                                                {"margin", "10"},
+                                                {"flexDirection", "row"},
+                                                {"width", "50%"}}));
+  scoped_refptr<nu::Container> c1(new nu::Container);
+  c1->SetStyle(style.get());
+  scoped_refptr<nu::Container> c2(new nu::Container);
+  c2->SetStyle("flex", 1, "margin", 10, "flex-direction", "row",
+               "width", "50%");
+  EXPECT_EQ(c1->GetComputedLayout(), c2->GetComputedLayout());
+}
@@ -16,6 +16,7 @@
 #include "base/win/windows_version.h"
 #include "nativeui/gfx/win/native_theme.h"
 #include "nativeui/screen.h"
+#include "nativeui/util/yoga_util.h"
 #include "nativeui/win/util/class_registrar.h"
 #include "nativeui/win/util/gdiplus_holder.h"
 #include "nativeui/win/util/scoped_ole_initializer.h"
@@ -30,7 +31,8 @@ namespace nu {
 void State::PlatformInit() {
   base::win::EnableHighDPISupport();
 
-  YGConfigSetPointScaleFactor(yoga_config(), Screen::GetDefaultScaleFactor());
+  YGConfigSetPointScaleFactor(yoga_config()->get(),
+                              Screen::GetDefaultScaleFactor());
 
   // Initialize Common Controls.
   INITCOMMONCONTROLSEX config;
@@ -10,6 +10,7 @@
 #include <set>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "base/strings/utf_string_conversions.h"
 #include "nativeui/gfx/attributed_text.h"
@@ -150,6 +151,10 @@ LRESULT TableImpl::OnNotify(int code, LPNMHDR pnmh) {
       auto* nm = reinterpret_cast<NMLVDISPINFO*>(pnmh);
       return OnEndEdit(nm, nm->item.iItem);
     }
+    case LVN_ODFINDITEM: {
+      auto* nm = reinterpret_cast<NMLVFINDITEM*>(pnmh);
+      return OnFindItem(nm);
+    }
     case LVN_ITEMACTIVATE: {
       static_assert(_WIN32_IE >= 0x0400);
       auto* nm = reinterpret_cast<NMITEMACTIVATE*>(pnmh);
@@ -188,6 +193,19 @@ LRESULT TableImpl::OnGetDispInfo(NMLVDISPINFO* nm, int column, int row) {
   return 0;
 }
 
+LRESULT TableImpl::OnFindItem(NMLVFINDITEM* nm) {
+  auto* table = static_cast<Table*>(delegate());
+  if (table->GetSearchColumn() < 0 || !(nm->lvfi.flags & LVFI_STRING))
+    return -1;
+  std::vector<int> rows = table->FindRows(base::WideToUTF8(nm->lvfi.psz));
+  auto it = std::lower_bound(rows.begin(), rows.end(), nm->iStart);
+  if (it != rows.end())
+    return *it;
+  if ((nm->lvfi.flags & LVFI_WRAP) && !rows.empty())
+    return rows.front();
+  return -1;
+}
+
 LRESULT TableImpl::OnCustomDraw(NMLVCUSTOMDRAW* nm, int row) {
   if (!has_custom_column_)
     return 0;
@@ -338,6 +356,9 @@ void Table::PlatformSetModel(TableModel* model) {
   }
 }
 
+void Table::PlatformSetSearchColumn(int column) {
+}
+
 void Table::AddColumnWithOptions(const std::string& title,
                                  const ColumnOptions& options) {
   auto* table = static_cast<TableImpl*>(GetNative());
@@ -424,21 +445,32 @@ std::set<int> Table::GetSelectedRows() const {
   return rows;
 }
 
-void Table::NotifyRowInsertion(uint32_t row) {
+void Table::OnRowsInserted(uint32_t start, uint32_t count) {
+  // The virtual list view only needs to know the new row count.
   auto* table = static_cast<TableImpl*>(GetNative());
   ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(),
                           LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
 }
 
-void Table::NotifyRowDeletion(uint32_t row) {
+void Table::OnRowsDeleted(uint32_t start, uint32_t count) {
   auto* table = static_cast<TableImpl*>(GetNative());
   ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(),
                           LVSICF_NOINVALIDATEALL | LVSICF_NOSCROLL);
 }
 
-void Table::NotifyValueChange(uint32_t column, uint32_t row) {
+void Table::OnRangeChanged(uint32_t start, uint32_t count) {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  ListView_RedrawItems(table->hwnd(), start, start + count - 1);
+}
+
+void Table::OnValueChanged(uint32_t column, uint32_t row) {
   auto* table = static_cast<TableImpl*>(GetNative());
   ListView_Update(table->hwnd(), row);
 }
 
+void Table::OnReset() {
+  auto* table = static_cast<TableImpl*>(GetNative());
+  ListView_SetItemCountEx(table->hwnd(), GetModel()->GetRowCount(), 0);
+}
+
 }  // namespace nu
@@ -40,6 +40,7 @@ class TableImpl : public SubwinView {
   void OnWindowPosChanged(WINDOWPOS* pos);
 
   LRESULT OnGetDispInfo(NMLVDISPINFO* nm, int column, int row);
+  LRESULT OnFindItem(NMLVFINDITEM* nm);
   LRESULT OnCustomDraw(NMLVCUSTOMDRAW* nm, int row);
   LRESULT OnBeginEdit(NMLVDISPINFO* nm, int row);
   LRESULT OnEndEdit(NMLVDISPINFO* nm, int row);
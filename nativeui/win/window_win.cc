@@ -34,6 +34,7 @@
 #include "nativeui/win/menu_base_win.h"
 #include "nativeui/win/screen_win.h"
 #include "nativeui/win/subwin_view.h"
+#include "nativeui/util/yoga_util.h"
 #include "nativeui/win/util/hwnd_util.h"
 #include "third_party/yoga/Yoga.h"
 
@@ -852,7 +853,7 @@ void Window::PlatformInit(const Options& options) {
   window_ = new WindowImpl(options, this);
 
   InitResponder(window_, Type::Window);
-  YGConfigSetPointScaleFactor(yoga_config_,
+  YGConfigSetPointScaleFactor(yoga_config_->get(),
                               GetScaleFactorForHWND(window_->hwnd()));
 }
 
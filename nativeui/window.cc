@@ -4,12 +4,14 @@
 
 #include "nativeui/window.h"
 
+#include <algorithm>
 #include <iostream>
 #include <utility>
 
 #include "nativeui/container.h"
 #include "nativeui/menu_bar.h"
-#include "third_party/yoga/Yoga.h"
+#include "nativeui/message_loop.h"
+#include "nativeui/util/yoga_util.h"
 
 #if defined(OS_MAC)
 #include "nativeui/toolbar.h"
@@ -23,7 +25,7 @@ const char Window::kClassName[] = "Window";
 Window::Window(const Options& options)
     : has_frame_(options.frame),
       transparent_(options.transparent),
-      yoga_config_(YGConfigNew()) {
+      yoga_config_(new YogaConfig) {
   // Initialize.
   PlatformInit(options);
   SetContentView(new Container);
@@ -37,7 +39,6 @@ Window::Window(const Options& options)
 
 Window::~Window() {
   PlatformDestroy();
-  YGConfigFree(yoga_config_);
   content_view_->BecomeContentView(nullptr);
 }
 
@@ -60,6 +61,44 @@ SizeF Window::GetContentSize() const {
 }
 #endif
 
+void Window::SetLayoutDeferred(bool deferred) {
+  layout_deferred_ = deferred;
+  if (!deferred)
+    FlushLayout();
+}
+
+void Window::ScheduleLayout(Container* root) {
+  auto it = std::find(pending_layouts_.begin(), pending_layouts_.end(), root);
+  if (it == pending_layouts_.end())
+    pending_layouts_.emplace_back(root);
+  if (layout_scheduled_)
+    return;
+  layout_scheduled_ = true;
+  PlatformScheduleLayout();
+}
+
+void Window::FlushLayout() {
+  layout_scheduled_ = false;
+  if (pending_layouts_.empty())
+    return;
+  std::vector<scoped_refptr<Container>> pending;
+  pending.swap(pending_layouts_);
+  // The root may have been moved to other window since it was scheduled.
+  for (const auto& root : pending) {
+    if (root->GetWindow() == this)
+      root->UpdateChildBounds();
+  }
+}
+
+#if defined(OS_WIN) || defined(OS_MAC)
+void Window::PlatformScheduleLayout() {
+  // There is no frame clock to hook into, run the layout in next iteration
+  // of message loop, which is still before the window gets painted.
+  scoped_refptr<Window> self(this);
+  MessageLoop::PostTask([self]() { self->FlushLayout(); });
+}
+#endif
+
 #if defined(OS_WIN) || defined(OS_LINUX)
 void Window::SetIcon(scoped_refptr<Image> icon) {
   PlatformSetIcon(icon.get());
@@ -120,6 +120,10 @@ class NATIVEUI_EXPORT Window : public Responder {
   void ReleaseCapture();
   bool HasCapture() const;
 
+  // Coalesce layout requests of children into one pass before next paint.
+  void SetLayoutDeferred(bool deferred);
+  bool IsLayoutDeferred() const { return layout_deferred_; }
+
 #if defined(OS_MAC)
   void SetToolbar(scoped_refptr<Toolbar> toolbar);
   Toolbar* GetToolbar() const { return toolbar_.get(); }
@@ -149,7 +153,13 @@ class NATIVEUI_EXPORT Window : public Responder {
   NativeWindow GetNative() const { return window_; }
 
   // Internal: Get the yogo config object.
-  YGConfigRef GetYogaConfig() const { return yoga_config_; }
+  YogaConfig* GetYogaConfig() const { return yoga_config_.get(); }
+
+  // Internal: Request a layout pass of the root container before next paint.
+  void ScheduleLayout(Container* root);
+
+  // Internal: Run the pending layout passes.
+  void FlushLayout();
 
   // Responder:
   const char* GetClassName() const override;
@@ -177,6 +187,7 @@ class NATIVEUI_EXPORT Window : public Responder {
 #endif
   void PlatformAddChildWindow(Window* child);
   void PlatformRemoveChildWindow(Window* child);
+  void PlatformScheduleLayout();
 
   // Whether window has a native chrome.
   bool has_frame_;
@@ -184,12 +195,17 @@ class NATIVEUI_EXPORT Window : public Responder {
   // Whether window is transparent.
   bool transparent_;
 
-  // The yoga config for window's children.
-  YGConfigRef yoga_config_;
+  // The yoga config shared by window's children.
+  scoped_refptr<YogaConfig> yoga_config_;
 
   // Whehter window has been closed.
   bool is_closed_ = false;
 
+  // Deferred layout state.
+  bool layout_deferred_ = false;
+  bool layout_scheduled_ = false;
+  std::vector<scoped_refptr<Container>> pending_layouts_;
+
 #if defined(OS_MAC)
   scoped_refptr<Toolbar> toolbar_;
 #endif